@@ -0,0 +1,121 @@
+#include "BinaryCache.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+const char binary_cache_magic[8] = {'T', 'C', 'B', 'C', 'A', 'C', 'H', 'E'};
+const uint64_t binary_cache_version = 1;
+}
+
+
+BinaryCacheHeader::BinaryCacheHeader()
+    : version(binary_cache_version),
+      num_examples(0),
+      num_features(0),
+      nnz(0),
+      footer_offset(0)
+{
+    std::memcpy(magic, binary_cache_magic, sizeof(magic));
+    return;
+}
+
+
+bool BinaryCacheHeader::is_valid() const
+{
+    return std::memcmp(magic, binary_cache_magic, sizeof(magic)) == 0 and version == binary_cache_version;
+}
+
+
+BinaryCacheWriter::BinaryCacheWriter(const std::string &filename)
+    : output_stream(filename.c_str(), std::ios::binary),
+      closed(false)
+{
+    if(not output_stream.good())
+    {
+        std::stringstream os;
+        os << "Cannot open cache file : " << filename << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    // rewritten by close()
+    output_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    return;
+}
+
+
+BinaryCacheWriter::~BinaryCacheWriter()
+{
+    if(not closed)
+    {
+        try
+        {
+            close();
+        }
+        catch(const std::exception &)
+        {
+            // destructors do not throw
+        }
+    }
+    return;
+}
+
+
+void BinaryCacheWriter::write_row(const int label,
+                                  const std::vector<size_t> &indices,
+                                  const std::vector<double> &values)
+{
+    const int32_t row_label = label;
+    const uint64_t row_nnz = indices.size();
+
+    output_stream.write(reinterpret_cast<const char *>(&row_label), sizeof(row_label));
+    output_stream.write(reinterpret_cast<const char *>(&row_nnz), sizeof(row_nnz));
+    for(size_t k = 0; k < indices.size(); k++)
+    {
+        const uint64_t index = indices[k];
+        output_stream.write(reinterpret_cast<const char *>(&index), sizeof(index));
+
+        if(index >= feature_nnz.size())
+        {
+            feature_nnz.resize(index + 1, 0);
+        }
+        feature_nnz[index] += 1;
+    }
+    if(not values.empty())
+    {
+        output_stream.write(reinterpret_cast<const char *>(&values[0]), values.size()*sizeof(double));
+    }
+
+    header.num_examples += 1;
+    header.nnz += row_nnz;
+    return;
+}
+
+
+void BinaryCacheWriter::close()
+{
+    header.num_features = feature_nnz.size();
+    header.footer_offset = output_stream.tellp();
+    if(not feature_nnz.empty())
+    {
+        output_stream.write(reinterpret_cast<const char *>(&feature_nnz[0]), feature_nnz.size()*sizeof(uint64_t));
+    }
+
+    output_stream.seekp(0, std::ios::beg);
+    output_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output_stream.close();
+    closed = true;
+
+    if(output_stream.fail())
+    {
+        throw std::runtime_error("BinaryCacheWriter: failed to write the cache");
+    }
+    return;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,70 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_BINARYCACHE_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_BINARYCACHE_HPP
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Binary dataset cache, much faster to load than LibSVM text.
+///
+/// Layout (native endianness):
+///   header:   BinaryCacheHeader
+///   examples: int32 label, uint64 nnz, nnz uint64 indices, nnz double values
+///   footer:   num_features uint64, the number of non zeros of each feature
+/// The footer lets LibSVMReader::readBinaryCache_transpose allocate the
+/// transposed data up front and load it in a single pass.
+class BinaryCacheHeader
+{
+public:
+    char magic[8];
+    uint64_t version;
+    uint64_t num_examples;
+    uint64_t num_features;
+    uint64_t nnz;
+    uint64_t footer_offset;
+
+    BinaryCacheHeader();
+
+    /// true if the magic and the version are the ones we write
+    bool is_valid() const;
+};
+
+
+/// Writes a binary cache one example at a time, with O(D) memory
+class BinaryCacheWriter
+{
+
+protected:
+
+    std::ofstream output_stream;
+
+    BinaryCacheHeader header;
+
+    std::vector<uint64_t> feature_nnz;
+
+    bool closed;
+
+public:
+
+    BinaryCacheWriter(const std::string &filename);
+
+    /// Closes the cache if needed
+    ~BinaryCacheWriter();
+
+    /// indices of the non zeros, starting at 1 as in LibSVM files
+    void write_row(const int label,
+                   const std::vector<size_t> &indices,
+                   const std::vector<double> &values);
+
+    /// Writes the footer and the header
+    void close();
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_BINARYCACHE_HPP
@@ -3,13 +3,14 @@
 #include "oracles/Svm.hpp"
 #include "oracles/DecisionStump.hpp"
 #include "weak_learners/AbstractWeakLearner.hpp"
-#include "weak_learners/DecisionStumpWeakLearner.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
 
 #include "LibSvmReader.hpp"
 #include "Ensemble.hpp"
 
 #include "math/vector_operations.hpp"
 #include "parse.hpp"
+#include "Profiler.hpp"
 
 #include <cmath>
 #include <iostream>
@@ -24,6 +25,14 @@ typedef std::vector<WeightedWeakLearner>::const_iterator wwl_citr;
 typedef std::vector<WeightedWeakLearner>::iterator wwl_itr;
 
 
+Ensemble::Ensemble()
+    : weak_learner_pool(new WeakLearnerPool)
+{
+    // nothing to do here
+    return;
+}
+
+
 // predict on a single example
 double Ensemble::predict(const DenseVector& x) const
 {
@@ -63,6 +72,7 @@ double Ensemble::predict(const SparseVector& x) const
 
 DenseVector Ensemble::predict(const std::vector<SparseVector>& data) const
 {
+    PROFILE_SCOPE(Profiler::evaluation);
 
     if(data.empty())
     {
@@ -159,19 +169,78 @@ void Ensemble::add_weight(const double& wt, const size_t& index)
 /// found weak learner
 bool Ensemble::add(const WeightedWeakLearner& wwl)
 {
+    size_t index = 0;
+    return add(wwl, index);
+}
+
+
+bool Ensemble::add(const WeightedWeakLearner& wwl, size_t& index)
+{
+    typedef boost::unordered_multimap<size_t, size_t>::const_iterator position_itr;
 
-    std::vector<WeightedWeakLearner>::iterator it =
-        std::find(ensemble.begin(), ensemble.end(), wwl);
+    const AbstractWeakLearner *weak_learner = wwl.get_weak_learner();
 
-    if(it == ensemble.end())
+    std::pair<position_itr, position_itr> range = learner_positions.equal_range(weak_learner->hash());
+    for(position_itr it = range.first; it != range.second; ++it)
     {
-        // did not find it in the ensemble
-        ensemble.push_back(wwl);
-        return false;
+        if(ensemble[it->second] == wwl)
+        {
+            index = it->second;
+            ensemble[index].add_weight(wwl.get_weight());
+            return true;
+        }
+    }
+
+    const SparseVector &prediction = weak_learner->get_prediction();
+    if(prediction.dim > 0)
+    {
+        range = prediction_positions.equal_range(hash_value(prediction));
+        for(position_itr it = range.first; it != range.second; ++it)
+        {
+            if(ensemble[it->second].get_weak_learner()->get_prediction() == prediction)
+            {
+                index = it->second;
+                ensemble[index].add_weight(wwl.get_weight());
+                return true;
+            }
+        }
     }
 
-    (*it).add_weight(wwl.get_weight());
-    return true;
+    // did not find it in the ensemble
+    index = ensemble.size();
+    append(wwl);
+    return false;
+}
+
+
+bool Ensemble::holds(const AbstractWeakLearner* wl) const
+{
+    typedef boost::unordered_multimap<size_t, size_t>::const_iterator position_itr;
+
+    std::pair<position_itr, position_itr> range = learner_positions.equal_range(wl->hash());
+    for(position_itr it = range.first; it != range.second; ++it)
+    {
+        if(ensemble[it->second].get_weak_learner() == wl)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void Ensemble::append(const WeightedWeakLearner& wwl)
+{
+    const size_t position = ensemble.size();
+    ensemble.push_back(wwl);
+
+    const AbstractWeakLearner *weak_learner = wwl.get_weak_learner();
+    learner_positions.insert(std::make_pair(weak_learner->hash(), position));
+    if(weak_learner->get_prediction().dim > 0)
+    {
+        prediction_positions.insert(std::make_pair(hash_value(weak_learner->get_prediction()), position));
+    }
+    return;
 }
 
 
@@ -211,21 +280,25 @@ std::istream& operator >> (std::istream& in, Ensemble& e)
         expect_keyword(in, "NUMWL");
         num_wls = expect_int(in);
         e.ensemble.clear();
+        e.learner_positions.clear();
+        e.prediction_positions.clear();
+        // the weak learners read so far go with the previous pool
+        e.weak_learner_pool.reset(new WeakLearnerPool);
         for (int i = 0; i < num_wls; i++)
         {
             if (wl_type == "DSTUMP")
             {
-                DecisionStumpWeakLearner *wl = new DecisionStumpWeakLearner;
+                DecisionStumpWeakLearner *wl = e.weak_learner_pool->new_stump();
                 WeightedWeakLearner wwl(wl,0.0);
                 in >> wwl;
-                e.ensemble.push_back(wwl);
+                e.append(wwl);
             }
             else if (wl_type == "RAWDATA")
             {
-                LinearWeakLearner *wl = new LinearWeakLearner;
+                LinearWeakLearner *wl = e.weak_learner_pool->new_linear();
                 WeightedWeakLearner wwl(wl,0.0);
                 in >> wwl;
-                e.ensemble.push_back(wwl);
+                e.append(wwl);
             }
             //     else if (wl_type == "SVM") {
             //       CWeakLearnerSVM *wl = new CWeakLearnerSVM;
@@ -4,6 +4,9 @@
 
 #include "weak_learners/WeightedWeakLearner.hpp"
 
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
+
 #include <vector>
 #include <iostream>
 
@@ -11,6 +14,8 @@
 namespace totally_corrective_boosting
 {
 
+class WeakLearnerPool; // forward declaration
+
 class Ensemble
 {
 
@@ -18,14 +23,41 @@ private:
 
     std::vector<WeightedWeakLearner> ensemble;
 
+    /// Positions in ensemble, by weak learner hash and by hash of the
+    /// training predictions (learners read from a model have none)
+    boost::unordered_multimap<size_t, size_t> learner_positions, prediction_positions;
+
+    /// Owns the weak learners of the ensemble (shared by the copies of
+    /// the ensemble, and by the oracle feeding it)
+    boost::shared_ptr<WeakLearnerPool> weak_learner_pool;
+
+    /// Appends to ensemble and indexes the weak learner
+    void append(const WeightedWeakLearner& wwl);
+
 public:
 
+    Ensemble();
+
+    const boost::shared_ptr<WeakLearnerPool>& get_weak_learner_pool() const
+    {
+        return weak_learner_pool;
+    }
+
+    /// true if wl itself (not an equal weak learner) is in the ensemble
+    bool holds(const AbstractWeakLearner* wl) const;
+
     /// return false if add was successful
     /// true if weak learner already exists
     /// in that case simply add the wt to the
-    /// found weak learner
+    /// found weak learner.
+    /// A different weak learner with the same predictions on the training
+    /// data counts as already existing (its column would be a duplicate)
     bool add(const WeightedWeakLearner& wwl);
 
+    /// Same as above, index is the position of the weak learner in the
+    /// ensemble (new or found)
+    bool add(const WeightedWeakLearner& wwl, size_t& index);
+
     // predict on single examples
     double predict(const SparseVector& x) const;
     double predict(const DenseVector& x) const;
@@ -52,6 +84,12 @@ public:
         return ensemble.size();
     }
 
+    const WeightedWeakLearner& operator[](const size_t index) const
+    {
+        assert(index < ensemble.size());
+        return ensemble[index];
+    }
+
     friend
     std::ostream& operator << (std::ostream& os, const Ensemble& e);
 
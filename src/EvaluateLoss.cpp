@@ -95,4 +95,28 @@ void EvaluateLoss::binary_loss(const DenseVector predictions,
     return;
 }
 
+
+void EvaluateLoss::binary_loss(const DenseVector predictions,
+                               const std::vector<int>& labels,
+                               const DenseVector& multiplicities,
+                               int& total_loss,
+                               double& percent_err) const
+{
+    assert(multiplicities.dim == predictions.dim);
+
+    double tmp_loss = 0.0;
+    double num_examples = 0.0;
+
+    for(size_t i = 0; i < predictions.dim; i++)
+    {
+        tmp_loss += multiplicities.val[i]*binary_loss(predictions.val[i], labels[i]);
+        num_examples += multiplicities.val[i];
+    }
+
+    total_loss = (int)tmp_loss;
+    percent_err = tmp_loss / num_examples;
+
+    return;
+}
+
 } // end of namespace totally_corrective_boosting
@@ -42,6 +42,12 @@ public:
     void binary_loss(const DenseVector predictions, const std::vector<int>& labels,
                      int& total_loss, double& percent_err) const;
 
+    // same as above, example i counts multiplicities[i] times
+    // (see deduplicate_examples)
+    void binary_loss(const DenseVector predictions, const std::vector<int>& labels,
+                     const DenseVector& multiplicities,
+                     int& total_loss, double& percent_err) const;
+
 };
 
 } // end of namespace totally_corrective_boosting
@@ -0,0 +1,181 @@
+#include "ExampleDeduplication.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+
+/// Moves the content of source into destination (source is left empty)
+void move_sparse_vector(SparseVector& source, SparseVector& destination)
+{
+    destination.reset();
+    std::swap(destination.val, source.val);
+    std::swap(destination.index, source.index);
+    std::swap(destination.nnz, source.nnz);
+    std::swap(destination.dim, source.dim);
+    return;
+}
+
+
+/// Rows of the transposed data (the features of each example)
+void transpose_rows(const std::vector<SparseVector>& data,
+                    const size_t num_examples,
+                    std::vector<SparseVector>& rows)
+{
+    std::vector<size_t> row_nnz(num_examples, 0);
+    for(size_t f = 0; f < data.size(); f++)
+    {
+        for(size_t k = 0; k < data[f].nnz; k++)
+        {
+            row_nnz[data[f].index[k]]++;
+        }
+    }
+
+    rows.resize(num_examples);
+    for(size_t i = 0; i < num_examples; i++)
+    {
+        rows[i].resize(data.size(), row_nnz[i]);
+        row_nnz[i] = 0;
+    }
+
+    // by increasing feature, the rows come out sorted
+    for(size_t f = 0; f < data.size(); f++)
+    {
+        for(size_t k = 0; k < data[f].nnz; k++)
+        {
+            SparseVector& row = rows[data[f].index[k]];
+            size_t& position = row_nnz[data[f].index[k]];
+            row.index[position] = f;
+            row.val[position] = data[f].val[k];
+            position++;
+        }
+    }
+    return;
+}
+
+} // end of anonymous namespace
+
+
+size_t deduplicate_examples(std::vector<SparseVector>& data,
+                            std::vector<int>& labels,
+                            const bool transposed,
+                            DenseVector& multiplicities)
+{
+    const size_t num_examples = labels.size();
+    if(not transposed and data.size() != num_examples)
+    {
+        throw std::invalid_argument("deduplicate_examples needs one label per example");
+    }
+
+    std::vector<SparseVector> transposed_rows;
+    if(transposed)
+    {
+        transpose_rows(data, num_examples, transposed_rows);
+    }
+    const std::vector<SparseVector>& rows = transposed? transposed_rows : data;
+
+    // Examples kept, by hash of their features and label
+    typedef boost::unordered_multimap<size_t, size_t>::const_iterator kept_itr;
+    boost::unordered_multimap<size_t, size_t> kept_positions;
+    std::vector<size_t> kept_examples;
+    std::vector<size_t> copies;
+
+    // Position of each example among the ones kept, num_examples if it
+    // is the copy of a previous one
+    std::vector<size_t> new_positions(num_examples, num_examples);
+
+    for(size_t i = 0; i < num_examples; i++)
+    {
+        size_t hash = hash_value(rows[i]);
+        boost::hash_combine(hash, labels[i]);
+
+        bool found = false;
+        std::pair<kept_itr, kept_itr> range = kept_positions.equal_range(hash);
+        for(kept_itr it = range.first; it != range.second; ++it)
+        {
+            const size_t kept = kept_examples[it->second];
+            if(labels[kept] == labels[i] and rows[kept] == rows[i])
+            {
+                copies[it->second]++;
+                found = true;
+                break;
+            }
+        }
+        if(not found)
+        {
+            new_positions[i] = kept_examples.size();
+            kept_positions.insert(std::make_pair(hash, kept_examples.size()));
+            kept_examples.push_back(i);
+            copies.push_back(1);
+        }
+    }
+
+    const size_t num_kept = kept_examples.size();
+    multiplicities.resize(num_kept);
+    for(size_t k = 0; k < num_kept; k++)
+    {
+        multiplicities.val[k] = copies[k];
+    }
+
+    if(num_kept == num_examples)
+    {
+        return num_kept;
+    }
+
+    for(size_t k = 0; k < num_kept; k++)
+    {
+        labels[k] = labels[kept_examples[k]];
+    }
+    labels.resize(num_kept);
+
+    if(not transposed)
+    {
+        for(size_t k = 0; k < num_kept; k++)
+        {
+            if(kept_examples[k] != k)
+            {
+                move_sparse_vector(data[kept_examples[k]], data[k]);
+            }
+        }
+        data.resize(num_kept);
+        return num_kept;
+    }
+
+    // Each feature keeps the entries of the examples kept, renumbered
+    // (in the same order, since the examples kept are)
+    transposed_rows.clear();
+    for(size_t f = 0; f < data.size(); f++)
+    {
+        SparseVector& feature = data[f];
+        size_t nnz = 0;
+        for(size_t k = 0; k < feature.nnz; k++)
+        {
+            nnz += (new_positions[feature.index[k]] < num_examples);
+        }
+
+        SparseVector compacted(num_kept, nnz);
+        size_t position = 0;
+        for(size_t k = 0; k < feature.nnz; k++)
+        {
+            const size_t new_position = new_positions[feature.index[k]];
+            if(new_position < num_examples)
+            {
+                compacted.index[position] = new_position;
+                compacted.val[position] = feature.val[k];
+                position++;
+            }
+        }
+        move_sparse_vector(compacted, feature);
+    }
+
+    return num_kept;
+}
+
+} // end of namespace totally_corrective_boosting
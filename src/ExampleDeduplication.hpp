@@ -0,0 +1,33 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_EXAMPLEDEDUPLICATION_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_EXAMPLEDEDUPLICATION_HPP
+
+#include "math/dense_vector.hpp"
+#include "math/sparse_vector.hpp"
+
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Collapses the identical examples (same features and same label) of
+/// the training data into the first of them, in place, and writes the
+/// number of copies of each example kept in multiplicities.
+///
+/// The boosters given the multiplicities (see
+/// AbstractBooster::set_example_multiplicities) keep the mass of all the
+/// copies of an example on the example kept: their distributions, edges
+/// and objectives are the ones of the full data, with every pass only
+/// going over the examples kept.
+///
+/// data is transposed (one sparse vector per feature, as read by
+/// readlibSVM_transpose) or not (one per example). The examples kept
+/// stay in the same order.
+/// @return the number of examples kept
+size_t deduplicate_examples(std::vector<SparseVector>& data,
+                            std::vector<int>& labels,
+                            const bool transposed,
+                            DenseVector& multiplicities);
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_EXAMPLEDEDUPLICATION_HPP
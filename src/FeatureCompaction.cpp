@@ -0,0 +1,79 @@
+#include "FeatureCompaction.hpp"
+
+#include <boost/unordered_map.hpp>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+
+/// true if all the entries of feature are equal
+bool is_constant(const SparseVector& feature)
+{
+    // the entries not stored are 0
+    const double value = (feature.nnz < feature.dim)? 0.0 : feature.value(0);
+    for(size_t k = 0; k < feature.nnz; k++)
+    {
+        if(feature.value(k) != value)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // end of anonymous namespace
+
+
+size_t compact_features(const std::vector<SparseVector>& data,
+                        const bool drop_constant,
+                        std::vector<SparseVector>& compacted,
+                        std::vector<size_t>& original_features)
+{
+    // Features kept, by hash
+    typedef boost::unordered_multimap<size_t, size_t>::const_iterator kept_itr;
+    boost::unordered_multimap<size_t, size_t> kept_positions;
+    original_features.clear();
+
+    for(size_t f = 0; f < data.size(); f++)
+    {
+        const SparseVector& feature = data[f];
+        if(drop_constant and is_constant(feature))
+        {
+            continue;
+        }
+
+        const size_t hash = hash_value(feature);
+        bool found = false;
+        std::pair<kept_itr, kept_itr> range = kept_positions.equal_range(hash);
+        for(kept_itr it = range.first; it != range.second; ++it)
+        {
+            if(data[original_features[it->second]] == feature)
+            {
+                found = true;
+                break;
+            }
+        }
+        if(not found)
+        {
+            kept_positions.insert(std::make_pair(hash, original_features.size()));
+            original_features.push_back(f);
+        }
+    }
+
+    if(original_features.empty() and not data.empty())
+    {
+        original_features.push_back(0);
+    }
+
+    compacted.clear();
+    compacted.reserve(original_features.size());
+    for(size_t k = 0; k < original_features.size(); k++)
+    {
+        compacted.push_back(data[original_features[k]]);
+    }
+    return compacted.size();
+}
+
+} // end of namespace totally_corrective_boosting
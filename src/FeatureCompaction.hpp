@@ -0,0 +1,29 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_FEATURECOMPACTION_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_FEATURECOMPACTION_HPP
+
+#include "math/sparse_vector.hpp"
+
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Copies into compacted the features of data (read using
+/// readlibSVM_transpose) that can give a weak learner of their own:
+/// the copies of an earlier feature are left out, and so are the
+/// features with the same value on every example if drop_constant (a
+/// decision stump on them always predicts the same label, as the stumps
+/// of any other feature can).
+///
+/// original_features[k] is the index in data of the feature k of
+/// compacted, see AbstractOracle::set_original_features. If every feature
+/// would be left out, the first one is kept.
+/// @return the number of features kept
+size_t compact_features(const std::vector<SparseVector>& data,
+                        const bool drop_constant,
+                        std::vector<SparseVector>& compacted,
+                        std::vector<size_t>& original_features);
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_FEATURECOMPACTION_HPP
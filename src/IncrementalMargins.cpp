@@ -0,0 +1,76 @@
+#include "IncrementalMargins.hpp"
+
+#include "math/vector_operations.hpp"
+#include "Profiler.hpp"
+
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+IncrementalMargins::IncrementalMargins(const std::vector<SparseVector> &data_,
+                                       const std::vector<int> &labels_)
+    : data(data_), labels(labels_)
+{
+    if(data.empty())
+    {
+        throw std::invalid_argument("IncrementalMargins requires a non empty dataset");
+    }
+
+    margins.resize(data[0].dim);
+    return;
+}
+
+
+IncrementalMargins::~IncrementalMargins()
+{
+    // nothing to do here
+    return;
+}
+
+
+void IncrementalMargins::update(const Ensemble &model)
+{
+    PROFILE_SCOPE(Profiler::evaluation);
+
+    // the ensemble only grows by appending new weak learners
+    assert(predictions.size() <= model.size());
+
+    for(size_t i = predictions.size(); i < model.size(); i++)
+    {
+        predictions.push_back(model[i].get_weak_learner()->predict(data));
+    }
+
+    for(size_t i = 0; i < margins.dim; i++)
+    {
+        margins.val[i] = 0.0;
+    }
+
+    for(size_t t = 0; t < predictions.size(); t++)
+    {
+        const double weight = model[t].get_weight();
+        if(weight != 0.0)
+        {
+            axpy(weight, predictions[t], margins, margins);
+        }
+    }
+
+    return;
+}
+
+
+const DenseVector &IncrementalMargins::get_margins() const
+{
+    return margins;
+}
+
+
+double IncrementalMargins::error() const
+{
+    int total_loss = 0;
+    double percent_error = 0;
+    score.binary_loss(margins, labels, total_loss, percent_error);
+    return percent_error;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,56 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_INCREMENTALMARGINS_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_INCREMENTALMARGINS_HPP
+
+#include "Ensemble.hpp"
+#include "EvaluateLoss.hpp"
+
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Keeps track of the margins of an ensemble on a held out dataset.
+/// The predictions of each weak learner are computed only once (when the
+/// weak learner is first seen), the totally corrective weight updates
+/// only require a weighted sum of the cached prediction columns.
+class IncrementalMargins
+{
+
+protected:
+
+    /// Held out data, read using readlibSVM_transpose
+    const std::vector<SparseVector> &data;
+
+    const std::vector<int> &labels;
+
+    /// Unweighted predictions of each weak learner of the ensemble,
+    /// in the same order as the ensemble
+    std::vector<DenseVector> predictions;
+
+    /// Current margins (unnormalized ensemble predictions)
+    DenseVector margins;
+
+    EvaluateLoss score;
+
+public:
+
+    /// data and labels are kept by reference, they must outlive this object
+    IncrementalMargins(const std::vector<SparseVector> &data,
+                       const std::vector<int> &labels);
+
+    ~IncrementalMargins();
+
+    /// Compute the predictions of the weak learners added since the last call
+    /// and recompute the margins with the current ensemble weights
+    void update(const Ensemble &model);
+
+    const DenseVector &get_margins() const;
+
+    /// @returns the binary error rate of the last updated ensemble
+    double error() const;
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_INCREMENTALMARGINS_HPP
@@ -1,6 +1,7 @@
 
 
 #include "LibSvmReader.hpp"
+#include "BinaryCache.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -463,4 +464,115 @@ int LibSVMReader::readlibSVM_transpose_fast(const std::string& filename,
     return 0;
 }
 
+
+int LibSVMReader::readBinaryCache_transpose(const std::string& filename,
+                                            std::vector<SparseVector>& data,
+                                            std::vector<int>& labels)
+{
+    std::ifstream data_file(filename.c_str(), std::ios::binary);
+    if(!data_file.good())
+    {
+        std::stringstream os;
+        os <<"Cannot open data file : " << filename << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    BinaryCacheHeader header;
+    data_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if(!data_file.good() or !header.is_valid())
+    {
+        std::stringstream os;
+        os <<"Not a binary cache (or written by another version) : " << filename << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    // the footer gives the size of each feature
+    std::vector<uint64_t> feature_nnz(header.num_features);
+    data_file.seekg(header.footer_offset, std::ios::beg);
+    if(header.num_features > 0)
+    {
+        data_file.read(reinterpret_cast<char *>(&feature_nnz[0]), header.num_features*sizeof(uint64_t));
+    }
+
+    data.clear();
+    data.resize(header.num_features);
+    for(size_t j = 0; j < data.size(); j++)
+    {
+        data[j].resize(header.num_examples, feature_nnz[j]);
+    }
+
+    // then a single pass over the examples
+    data_file.seekg(sizeof(header), std::ios::beg);
+
+    std::vector<size_t> index_counter(header.num_features, 0);
+    std::vector<uint64_t> indices;
+    std::vector<double> values;
+    labels.resize(header.num_examples);
+    for(size_t i = 0; i < header.num_examples; i++)
+    {
+        int32_t label = 0;
+        uint64_t row_nnz = 0;
+        data_file.read(reinterpret_cast<char *>(&label), sizeof(label));
+        data_file.read(reinterpret_cast<char *>(&row_nnz), sizeof(row_nnz));
+        labels[i] = label;
+
+        indices.resize(row_nnz);
+        values.resize(row_nnz);
+        if(row_nnz > 0)
+        {
+            data_file.read(reinterpret_cast<char *>(&indices[0]), row_nnz*sizeof(uint64_t));
+            data_file.read(reinterpret_cast<char *>(&values[0]), row_nnz*sizeof(double));
+        }
+
+        if(!data_file.good())
+        {
+            std::stringstream os;
+            os <<"Truncated binary cache : " << filename << std::endl;
+            throw std::runtime_error(os.str());
+        }
+
+        for(size_t k = 0; k < row_nnz; k++)
+        {
+            const size_t index = indices[k];
+            if(index >= header.num_features or index_counter[index] >= feature_nnz[index])
+            {
+                std::stringstream os;
+                os <<"Binary cache rows do not match its header and footer : " << filename << std::endl;
+                throw std::invalid_argument(os.str());
+            }
+            data[index].index[index_counter[index]] = i;
+            data[index].val[index_counter[index]] = values[k];
+            index_counter[index]++;
+        }
+    }
+
+    data_file.close();
+
+    std::cout << "Data File: " << filename << std::endl;
+    std::cout << "Number of data points " << labels.size() << std::endl;
+    std::cout << "Maximum index " << (data.empty()? 0 : data.size() - 1) << std::endl;
+    std::cout << "Non zero elements " << header.nnz << std::endl;
+    std::cout << std::endl << "-----------------------" << std::endl;
+
+    return 0;
+}
+
+
+int LibSVMReader::read_transpose(const std::string& filename,
+                                 std::vector<SparseVector>& data,
+                                 std::vector<int>& labels)
+{
+    std::ifstream data_file(filename.c_str(), std::ios::binary);
+    BinaryCacheHeader header;
+    data_file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    const bool is_binary_cache = data_file.good() and header.is_valid();
+    data_file.close();
+
+    if(is_binary_cache)
+    {
+        return readBinaryCache_transpose(filename, data, labels);
+    }
+    return readlibSVM_transpose(filename, data, labels);
+}
+
 } // end of namespace totally_corrective_boosting
@@ -35,6 +35,17 @@ public:
                                   std::vector<SparseVector>& data,
                                   std::vector<int>& labels);
 
+    // Same as readlibSVM_transpose, from a binary cache
+    // (see BinaryCache.hpp, written by generate_dataset)
+    int readBinaryCache_transpose(const std::string& filename,
+                                  std::vector<SparseVector>& data,
+                                  std::vector<int>& labels);
+
+    // Binary cache or LibSVM text, based on the content of the file
+    int read_transpose(const std::string& filename,
+                       std::vector<SparseVector>& data,
+                       std::vector<int>& labels);
+
 };
 
 typedef std::vector<double>::iterator dbl_itr;
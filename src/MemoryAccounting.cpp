@@ -0,0 +1,250 @@
+#include "MemoryAccounting.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+
+namespace totally_corrective_boosting
+{
+
+namespace MemoryAccounting
+{
+
+const char *tag_names[num_tags] =
+{
+    "data",
+    "sorted_data",
+    "optimizer_columns",
+    "optimizer_solution",
+    "weak_learner_predictions"
+};
+
+/// Updated with atomic builtins, so that the oracles and solvers
+/// can account from within parallel regions
+size_t tag_current_bytes[num_tags] = {0};
+size_t tag_peak_bytes[num_tags] = {0};
+
+
+const char *tag_name(const Tag tag)
+{
+    if(tag < 0 or tag >= num_tags)
+    {
+        return "unknown";
+    }
+    return tag_names[tag];
+}
+
+
+void allocate(const Tag tag, const size_t bytes)
+{
+    const size_t current = __sync_add_and_fetch(&tag_current_bytes[tag], bytes);
+
+    size_t observed_peak = tag_peak_bytes[tag];
+    while(current > observed_peak)
+    {
+        const size_t previous_peak = __sync_val_compare_and_swap(&tag_peak_bytes[tag], observed_peak, current);
+        if(previous_peak == observed_peak)
+        {
+            break;
+        }
+        observed_peak = previous_peak;
+    }
+    return;
+}
+
+
+void release(const Tag tag, const size_t bytes)
+{
+    __sync_sub_and_fetch(&tag_current_bytes[tag], bytes);
+    return;
+}
+
+
+size_t current_bytes(const Tag tag)
+{
+    return __sync_add_and_fetch(&tag_current_bytes[tag], 0);
+}
+
+
+size_t peak_bytes(const Tag tag)
+{
+    return __sync_add_and_fetch(&tag_peak_bytes[tag], 0);
+}
+
+
+size_t bytes(const SparseVector &vector)
+{
+    if(vector.pattern_only())
+    {
+        return vector.nnz*sizeof(size_t);
+    }
+    return vector.nnz*(sizeof(double) + sizeof(size_t));
+}
+
+
+size_t bytes(const DenseVector &vector)
+{
+    return vector.dim*sizeof(double);
+}
+
+
+size_t bytes(const DenseIntegerVector &vector)
+{
+    return vector.dim*sizeof(size_t);
+}
+
+
+size_t bytes(const std::vector<SparseVector> &vectors)
+{
+    size_t total = 0;
+    for(size_t i = 0; i < vectors.size(); i++)
+    {
+        total += bytes(vectors[i]);
+    }
+    return total;
+}
+
+
+void report(std::ostream &os)
+{
+    os << "Memory per subsystem (current / peak MiB):" << std::endl;
+    for(int t = 0; t < num_tags; t++)
+    {
+        const Tag tag = static_cast<Tag>(t);
+        os << "    " << tag_name(tag) << ": "
+           << current_bytes(tag)/1048576.0 << " / "
+           << peak_bytes(tag)/1048576.0 << std::endl;
+    }
+    return;
+}
+
+
+MemoryEstimate::MemoryEstimate()
+{
+    for(int t = 0; t < num_tags; t++)
+    {
+        bytes[t] = 0;
+    }
+    return;
+}
+
+
+size_t MemoryEstimate::total() const
+{
+    size_t result = 0;
+    for(int t = 0; t < num_tags; t++)
+    {
+        result += bytes[t];
+    }
+    return result;
+}
+
+
+MemoryEstimate estimate(const ConfigFile &config,
+                        const std::vector<SparseVector> &data,
+                        const std::vector<int> &labels)
+{
+    std::string oracle_type, booster_type;
+    config.readInto(oracle_type, "oracle_type", std::string("decisionstump"));
+    config.readInto(booster_type, "booster_type", std::string("ERLPBoost"));
+
+    int max_iterations = 0;
+    config.readInto(max_iterations, "max_iter");
+
+    bool binary = false;
+    config.readInto(binary, "binary", false);
+
+    const size_t num_examples = labels.size();
+    const size_t num_features = data.size();
+    const size_t num_iterations = std::max(max_iterations, 0);
+
+    // the binary features (all nonzero entries 1)
+    size_t total_nnz = 0, unit_nnz = 0, num_unit_features = 0;
+    for(size_t i = 0; i < data.size(); i++)
+    {
+        total_nnz += data[i].nnz;
+        if(data[i].unit_values())
+        {
+            unit_nnz += data[i].nnz;
+            num_unit_features++;
+        }
+    }
+
+    const size_t sparse_entry_bytes = sizeof(double) + sizeof(size_t);
+
+    MemoryEstimate result;
+    result.bytes[MemoryAccounting::data] = total_nnz*sparse_entry_bytes;
+
+    if(oracle_type == "decisionstump")
+    {
+        // the binary features are kept pattern-only and are not sorted
+        result.bytes[MemoryAccounting::data] -= unit_nnz*sizeof(double);
+
+        // one argsorted index per non zero (plus the implicit zero)
+        result.bytes[sorted_data] = (total_nnz - unit_nnz + num_features - num_unit_features)*sizeof(size_t);
+
+        // stumps predict on all the examples
+        result.bytes[weak_learner_predictions] = num_iterations*num_examples*sparse_entry_bytes;
+    }
+    else if(oracle_type == "rawdata")
+    {
+        // the predictions are (signed) columns of the data
+        const size_t average_column_nnz = num_features > 0? total_nnz/num_features : 0;
+        result.bytes[weak_learner_predictions] = num_iterations*average_column_nnz*sparse_entry_bytes;
+    }
+    else
+    {
+        result.bytes[weak_learner_predictions] = num_iterations*num_examples*sparse_entry_bytes;
+    }
+
+    const bool totally_corrective = (booster_type == "ERLPBoost"
+                                     or booster_type == "ErlpBoost"
+                                     or booster_type == "KlBoost"
+                                     or booster_type == "tKlBoost");
+    if(totally_corrective)
+    {
+        // the optimizer stores dense columns
+        result.bytes[optimizer_columns] = num_iterations*num_examples*sizeof(double);
+        result.bytes[optimizer_solution] = (num_iterations + (binary? 1 : num_examples))*sizeof(double);
+    }
+
+    return result;
+}
+
+
+void enforce_budget(const ConfigFile &config,
+                    const std::vector<SparseVector> &data,
+                    const std::vector<int> &labels,
+                    std::ostream &log_stream)
+{
+    double budget_megabytes = 0;
+    config.readInto(budget_megabytes, "memory_budget_mb", 0.0);
+
+    const MemoryEstimate memory_estimate = estimate(config, data, labels);
+
+    std::stringstream breakdown;
+    breakdown << "Estimated memory: " << memory_estimate.total()/1048576.0 << " MiB (";
+    for(int t = 0; t < num_tags; t++)
+    {
+        breakdown << (t > 0? ", " : "") << tag_name(static_cast<Tag>(t)) << " "
+                  << memory_estimate.bytes[t]/1048576.0;
+    }
+    breakdown << ")";
+
+    log_stream << breakdown.str() << std::endl;
+
+    if(budget_megabytes > 0 and memory_estimate.total() > budget_megabytes*1048576.0)
+    {
+        std::stringstream error_message;
+        error_message << breakdown.str() << " exceeds memory_budget_mb = " << budget_megabytes
+                      << ". Reduce max_iter, or use a sparser oracle.";
+        throw std::runtime_error(error_message.str());
+    }
+
+    return;
+}
+
+} // end of namespace MemoryAccounting
+
+} // end of namespace totally_corrective_boosting
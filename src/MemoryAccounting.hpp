@@ -0,0 +1,86 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_MEMORYACCOUNTING_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_MEMORYACCOUNTING_HPP
+
+#include "math/sparse_vector.hpp"
+#include "math/dense_vector.hpp"
+#include "math/dense_integer_vector.hpp"
+#include "ConfigFile.hpp"
+
+#include <vector>
+#include <iostream>
+
+namespace totally_corrective_boosting
+{
+
+/// Lightweight accounting of the memory held by each subsystem.
+///
+/// The owners of the big arrays report what they allocate and release,
+/// the current and peak bytes are kept per tag (thread safe, lock free).
+/// This is not an allocator, the numbers only cover the tagged structures.
+namespace MemoryAccounting
+{
+
+enum Tag
+{
+    /// Copy of the training data held by the oracle
+    data = 0,
+    /// Argsorted features of the DecisionStump oracle
+    sorted_data,
+    /// Columns U of the totally corrective optimizer
+    optimizer_columns,
+    /// Solution vector x (w and psi) of the optimizer
+    optimizer_solution,
+    /// Prediction vectors held by every weak learner
+    weak_learner_predictions,
+    num_tags
+};
+
+const char *tag_name(const Tag tag);
+
+void allocate(const Tag tag, const size_t bytes);
+
+void release(const Tag tag, const size_t bytes);
+
+size_t current_bytes(const Tag tag);
+
+size_t peak_bytes(const Tag tag);
+
+/// Heap bytes held by the vectors
+size_t bytes(const SparseVector &vector);
+size_t bytes(const DenseVector &vector);
+size_t bytes(const DenseIntegerVector &vector);
+size_t bytes(const std::vector<SparseVector> &vectors);
+
+/// Current and peak bytes of each tag
+void report(std::ostream &os);
+
+
+/// Up front estimate of the peak memory needed by a configuration
+class MemoryEstimate
+{
+public:
+    size_t bytes[num_tags];
+
+    MemoryEstimate();
+
+    size_t total() const;
+};
+
+/// Estimate the memory needed to boost for max_iter iterations on data
+/// (read with readlibSVM_transpose), based on the oracle_type,
+/// booster_type and optimizer_type of the configuration
+MemoryEstimate estimate(const ConfigFile &config,
+                        const std::vector<SparseVector> &data,
+                        const std::vector<int> &labels);
+
+/// Throws if the estimate exceeds memory_budget_mb (0 or missing means no budget)
+void enforce_budget(const ConfigFile &config,
+                    const std::vector<SparseVector> &data,
+                    const std::vector<int> &labels,
+                    std::ostream &log_stream);
+
+} // end of namespace MemoryAccounting
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_MEMORYACCOUNTING_HPP
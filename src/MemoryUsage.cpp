@@ -0,0 +1,45 @@
+#include "MemoryUsage.hpp"
+
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+
+namespace totally_corrective_boosting
+{
+
+size_t resident_memory_bytes()
+{
+    std::ifstream statm_stream("/proc/self/statm");
+
+    // total program size, then resident set size, in pages
+    size_t size_pages = 0, resident_pages = 0;
+    if(not (statm_stream >> size_pages >> resident_pages))
+    {
+        return 0;
+    }
+
+    return resident_pages*sysconf(_SC_PAGESIZE);
+}
+
+
+size_t peak_resident_memory_bytes()
+{
+    std::ifstream status_stream("/proc/self/status");
+
+    std::string key;
+    while(status_stream >> key)
+    {
+        if(key == "VmHWM:")
+        {
+            size_t peak_kilobytes = 0;
+            status_stream >> peak_kilobytes;
+            return peak_kilobytes*1024;
+        }
+        std::getline(status_stream, key);
+    }
+
+    return 0;
+}
+
+} // end of namespace totally_corrective_boosting
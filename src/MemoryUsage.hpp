@@ -0,0 +1,19 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_MEMORYUSAGE_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_MEMORYUSAGE_HPP
+
+#include <cstddef>
+
+namespace totally_corrective_boosting
+{
+
+/// Current resident set size of the process, in bytes
+/// (read from /proc/self/statm, 0 if not available)
+size_t resident_memory_bytes();
+
+/// Peak resident set size of the process, in bytes
+/// (VmHWM in /proc/self/status, 0 if not available)
+size_t peak_resident_memory_bytes();
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_MEMORYUSAGE_HPP
@@ -0,0 +1,253 @@
+#include "MetricsWriter.hpp"
+
+#include <boost/bind.hpp>
+
+#include <stdint.h>
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+IterationRecord::IterationRecord()
+    : iteration(0), converged(false),
+      feature_index(0), threshold(0.0), direction(false), edge(0.0),
+      primal_bound(std::numeric_limits<double>::quiet_NaN()),
+      dual_bound(std::numeric_limits<double>::quiet_NaN()),
+      gap(std::numeric_limits<double>::quiet_NaN()),
+      solver_iterations(std::numeric_limits<double>::quiet_NaN()),
+      function_evaluations(std::numeric_limits<double>::quiet_NaN()),
+      gradient_evaluations(std::numeric_limits<double>::quiet_NaN()),
+      solver_tolerance(std::numeric_limits<double>::quiet_NaN()),
+      oracle_time(0.0), solver_time(0.0), iteration_time(0.0),
+      ensemble_size(0), resident_memory(0), peak_resident_memory(0)
+{
+    for(int t = 0; t < MemoryAccounting::num_tags; t++)
+    {
+        tagged_memory[t] = 0;
+        peak_tagged_memory[t] = 0;
+    }
+    return;
+}
+
+
+MetricsSink::~MetricsSink()
+{
+    // nothing to do here
+    return;
+}
+
+
+void MetricsRecorder::write(const IterationRecord &record)
+{
+    records.push_back(record);
+    return;
+}
+
+
+/// Names of the fixed fields, in the order used by write_record
+/// (followed by the current and peak memory of each MemoryAccounting tag)
+const char *record_fields[] =
+{
+    "iteration", "converged",
+    "feature", "threshold", "direction", "edge",
+    "primal_bound", "dual_bound", "gap",
+    "solver_iterations", "function_evaluations", "gradient_evaluations", "solver_tolerance",
+    "oracle_time", "solver_time", "iteration_time",
+    "ensemble_size", "resident_memory", "peak_resident_memory"
+};
+
+const size_t num_record_fields = sizeof(record_fields)/sizeof(record_fields[0]);
+
+
+MetricsWriter::MetricsWriter(const std::string &filename, const std::string &format_)
+    : format(format_ == "csv"? Csv : JsonLines),
+      stop_requested(false)
+{
+    if(format_ != "csv" and format_ != "jsonl")
+    {
+        std::stringstream error_message;
+        error_message << "Unknown metrics format " << format_ << " (expected jsonl or csv)";
+        throw std::invalid_argument(error_message.str());
+    }
+
+    output_stream.open(filename.c_str());
+    if(not output_stream.good())
+    {
+        std::stringstream error_message;
+        error_message << "Cannot open metrics file : " << filename;
+        throw std::invalid_argument(error_message.str());
+    }
+
+    field_names.assign(record_fields, record_fields + num_record_fields);
+    for(int t = 0; t < MemoryAccounting::num_tags; t++)
+    {
+        const std::string tag_name = MemoryAccounting::tag_name(static_cast<MemoryAccounting::Tag>(t));
+        field_names.push_back(tag_name + "_bytes");
+        field_names.push_back(tag_name + "_peak_bytes");
+    }
+
+    write_header();
+
+    writer_thread.reset(new boost::thread(boost::bind(&MetricsWriter::writer_loop, this)));
+    return;
+}
+
+
+MetricsWriter::~MetricsWriter()
+{
+    {
+        boost::mutex::scoped_lock lock(records_mutex);
+        stop_requested = true;
+    }
+    records_available.notify_one();
+    writer_thread->join();
+
+    output_stream.close();
+    return;
+}
+
+
+void MetricsWriter::write(const IterationRecord &record)
+{
+    {
+        boost::mutex::scoped_lock lock(records_mutex);
+        pending_records.push_back(record);
+    }
+    records_available.notify_one();
+    return;
+}
+
+
+void MetricsWriter::writer_loop()
+{
+    bool stop = false;
+    while(not stop)
+    {
+        {
+            boost::mutex::scoped_lock lock(records_mutex);
+            while(pending_records.empty() and not stop_requested)
+            {
+                records_available.wait(lock);
+            }
+
+            // take everything that is pending, write() keeps filling the other buffer
+            writing_records.swap(pending_records);
+            stop = stop_requested;
+        }
+
+        for(size_t r = 0; r < writing_records.size(); r++)
+        {
+            write_record(writing_records[r]);
+        }
+        writing_records.clear();
+        output_stream.flush();
+    }
+
+    return;
+}
+
+
+void MetricsWriter::write_header()
+{
+    if(format == Csv)
+    {
+        for(size_t f = 0; f < field_names.size(); f++)
+        {
+            output_stream << (f > 0? "," : "") << field_names[f];
+        }
+        output_stream << "\n";
+    }
+    return;
+}
+
+
+bool is_undefined_value(const double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint64_t exponent_mask = 0x7ff0000000000000ull;
+    return (bits & exponent_mask) == exponent_mask;
+}
+
+
+/// Helper that formats a value for the metrics file
+template<typename T>
+std::string format_value(const T &value)
+{
+    std::ostringstream value_stream;
+    value_stream.precision(10);
+    value_stream << value;
+    return value_stream.str();
+}
+
+
+/// Same as format_value, NaN (and infinite) values are written as the missing
+/// value of the format
+std::string format_optional_value(const double value, const MetricsWriter::Format format)
+{
+    if(is_undefined_value(value))
+    {
+        return (format == MetricsWriter::JsonLines)? "null" : "";
+    }
+    return format_value(value);
+}
+
+
+void MetricsWriter::write_record(const IterationRecord &record)
+{
+    std::vector<std::string> values;
+    values.reserve(field_names.size());
+
+    values.push_back(format_value(record.iteration));
+    values.push_back(record.converged? "true" : "false");
+    values.push_back(format_value(record.feature_index));
+    values.push_back(format_value(record.threshold));
+    values.push_back(record.direction? "true" : "false");
+    values.push_back(format_value(record.edge));
+    values.push_back(format_optional_value(record.primal_bound, format));
+    values.push_back(format_optional_value(record.dual_bound, format));
+    values.push_back(format_optional_value(record.gap, format));
+    values.push_back(format_optional_value(record.solver_iterations, format));
+    values.push_back(format_optional_value(record.function_evaluations, format));
+    values.push_back(format_optional_value(record.gradient_evaluations, format));
+    values.push_back(format_optional_value(record.solver_tolerance, format));
+    values.push_back(format_value(record.oracle_time));
+    values.push_back(format_value(record.solver_time));
+    values.push_back(format_value(record.iteration_time));
+    values.push_back(format_value(record.ensemble_size));
+    values.push_back(format_value(record.resident_memory));
+    values.push_back(format_value(record.peak_resident_memory));
+    for(int t = 0; t < MemoryAccounting::num_tags; t++)
+    {
+        values.push_back(format_value(record.tagged_memory[t]));
+        values.push_back(format_value(record.peak_tagged_memory[t]));
+    }
+    assert(values.size() == field_names.size());
+
+    if(format == JsonLines)
+    {
+        output_stream << "{";
+        for(size_t f = 0; f < values.size(); f++)
+        {
+            output_stream << (f > 0? ", \"" : "\"") << field_names[f] << "\": " << values[f];
+        }
+        output_stream << "}\n";
+    }
+    else
+    {
+        for(size_t f = 0; f < values.size(); f++)
+        {
+            output_stream << (f > 0? "," : "") << values[f];
+        }
+        output_stream << "\n";
+    }
+
+    return;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,147 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_METRICSWRITER_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_METRICSWRITER_HPP
+
+#include "MemoryAccounting.hpp"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+namespace totally_corrective_boosting
+{
+
+/// Everything we know about one boosting iteration.
+/// Quantities that a booster does not define are left to NaN
+/// (written as null in JSON, as an empty field in CSV).
+class IterationRecord
+{
+public:
+
+    int iteration;
+
+    /// true when the stopping criterion fired at this iteration
+    /// (the weak learner was then not added to the ensemble)
+    bool converged;
+
+    /// Weak learner returned by the oracle
+    size_t feature_index;
+    double threshold;
+    bool direction;
+    double edge;
+
+    /// Upper (min_t P^t(d^{t-1})) and lower (P^{t-1}(d^{t-1})) bounds
+    double primal_bound, dual_bound, gap;
+
+    /// Effort of the inner solver for this iteration
+    double solver_iterations;
+    double function_evaluations;
+    double gradient_evaluations;
+
+    /// Duality gap tolerance of the inner solve (see AbstractOptimizer::set_gap_tolerance)
+    double solver_tolerance;
+
+    /// Wall clock time (in seconds)
+    double oracle_time, solver_time, iteration_time;
+
+    size_t ensemble_size;
+
+    /// In bytes
+    size_t resident_memory, peak_resident_memory;
+
+    /// Current and peak bytes of each MemoryAccounting tag
+    size_t tagged_memory[MemoryAccounting::num_tags];
+    size_t peak_tagged_memory[MemoryAccounting::num_tags];
+
+    IterationRecord();
+};
+
+
+/// Receives the IterationRecords of a booster
+class MetricsSink
+{
+public:
+    virtual ~MetricsSink();
+
+    virtual void write(const IterationRecord &record) = 0;
+};
+
+
+/// Keeps the IterationRecords in memory (used by the benchmarks)
+class MetricsRecorder: public MetricsSink
+{
+public:
+    std::vector<IterationRecord> records;
+
+    void write(const IterationRecord &record);
+};
+
+
+/// Writes IterationRecords as JSON lines or as CSV.
+///
+/// The records are formatted and written by a background thread,
+/// write() only appends to an in-memory buffer (the two buffers are
+/// swapped when the writer thread wakes up) so logging never stalls
+/// the boosting loop on disk I/O.
+class MetricsWriter: public MetricsSink
+{
+
+public:
+
+    enum Format
+    {
+        JsonLines,
+        Csv
+    };
+
+protected:
+
+    std::ofstream output_stream;
+
+    const Format format;
+
+    /// Records waiting to be written, filled by write()
+    std::vector<IterationRecord> pending_records;
+
+    /// Records being written by the writer thread
+    std::vector<IterationRecord> writing_records;
+
+    boost::mutex records_mutex;
+    boost::condition_variable records_available;
+    bool stop_requested;
+
+    boost::scoped_ptr<boost::thread> writer_thread;
+
+    void writer_loop();
+
+    /// Field names, in the order used by write_record
+    std::vector<std::string> field_names;
+
+    void write_header();
+    void write_record(const IterationRecord &record);
+
+public:
+
+    /// @param format "jsonl" or "csv"
+    MetricsWriter(const std::string &filename, const std::string &format);
+
+    /// Flushes all the pending records
+    ~MetricsWriter();
+
+    /// Queue a record, returns immediately
+    void write(const IterationRecord &record);
+
+};
+
+
+/// true when value is NaN or infinite, i.e. a quantity that cannot be written
+/// as a number (null in JSON). Tested on the bits: -ffast-math drops std::isnan
+bool is_undefined_value(const double value);
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_METRICSWRITER_HPP
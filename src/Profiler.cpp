@@ -0,0 +1,429 @@
+#include "Profiler.hpp"
+
+#include <boost/thread/mutex.hpp>
+
+#include <time.h>
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+#if defined(PROFILER_USE_TSC)
+#include <x86intrin.h>
+#endif
+
+namespace totally_corrective_boosting
+{
+
+namespace Profiler
+{
+
+const char *phase_names[num_phases] =
+{
+    "oracle_scan",
+    "oracle_sort",
+    "ensemble_update",
+    "distribution_update",
+    "solver_function",
+    "solver_gradient",
+    "projection",
+    "evaluation"
+};
+
+
+const char *phase_name(const Phase phase)
+{
+    if(phase < 0 or phase >= num_phases)
+    {
+        return "unknown";
+    }
+    return phase_names[phase];
+}
+
+
+uint64_t monotonic_clock_ns()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec)*1000000000ull + uint64_t(ts.tv_nsec);
+}
+
+
+#if defined(PROFILER_USE_TSC)
+
+/// Measure the TSC frequency against the monotonic clock
+double calibrate_tsc()
+{
+    const uint64_t calibration_ns = 20000000; // 20 ms
+
+    const uint64_t start_ns = monotonic_clock_ns();
+    const uint64_t start_ticks = __rdtsc();
+    uint64_t end_ns = start_ns;
+    while(end_ns - start_ns < calibration_ns)
+    {
+        end_ns = monotonic_clock_ns();
+    }
+    const uint64_t end_ticks = __rdtsc();
+
+    return double(end_ns - start_ns)/double(end_ticks - start_ticks);
+}
+
+const double ns_per_tick = calibrate_tsc();
+
+uint64_t now_ns()
+{
+    return uint64_t(double(__rdtsc())*ns_per_tick);
+}
+
+#else
+
+uint64_t now_ns()
+{
+    return monotonic_clock_ns();
+}
+
+#endif // PROFILER_USE_TSC
+
+
+/// One node of the call tree, i.e. one phase reached through a given path
+class ProfileNode
+{
+public:
+    Phase phase;
+    int parent;
+
+    /// index of the child node for each phase, -1 if never entered
+    int children[num_phases];
+
+    uint64_t num_calls;
+    uint64_t total_ns, min_ns, max_ns;
+
+    ProfileNode(const Phase phase_, const int parent_)
+        : phase(phase_), parent(parent_),
+          num_calls(0), total_ns(0),
+          min_ns(std::numeric_limits<uint64_t>::max()), max_ns(0)
+    {
+        std::fill(children, children + num_phases, -1);
+        return;
+    }
+};
+
+
+class TraceEvent
+{
+public:
+    Phase phase;
+    uint64_t start_ns, duration_ns;
+};
+
+
+/// Measurements of a single thread, only accessed by that thread
+/// (except when exporting)
+class ThreadProfile
+{
+public:
+    int thread_index;
+
+    /// node 0 is the root, it does not correspond to any phase
+    std::vector<ProfileNode> nodes;
+    int current_node;
+
+    /// start time of each open phase
+    std::vector<uint64_t> start_times;
+
+    std::vector<TraceEvent> events;
+
+    explicit ThreadProfile(const int thread_index_)
+        : thread_index(thread_index_), current_node(0)
+    {
+        clear();
+        return;
+    }
+
+    /// Forget the measurements, the phases still open stay open (and
+    /// are measured from now on) so that their leave() still matches
+    void clear()
+    {
+        std::vector<Phase> open_phases;
+        for(int n = current_node; n > 0; n = nodes[n].parent)
+        {
+            open_phases.push_back(nodes[n].phase);
+        }
+        std::reverse(open_phases.begin(), open_phases.end());
+
+        nodes.clear();
+        nodes.push_back(ProfileNode(num_phases, -1));
+        current_node = 0;
+        for(size_t k = 0; k < open_phases.size(); k++)
+        {
+            const int child = nodes.size();
+            nodes.push_back(ProfileNode(open_phases[k], current_node));
+            nodes[current_node].children[open_phases[k]] = child;
+            current_node = child;
+        }
+
+        std::fill(start_times.begin(), start_times.end(), now_ns());
+        events.clear();
+        return;
+    }
+};
+
+
+/// All the thread profiles ever created, they live until the program ends
+std::vector<ThreadProfile *> thread_profiles;
+boost::mutex thread_profiles_mutex;
+
+__thread ThreadProfile *thread_profile = NULL;
+
+bool tracing_enabled = false;
+size_t max_trace_events = 0;
+
+
+ThreadProfile &get_thread_profile()
+{
+    if(thread_profile == NULL)
+    {
+        boost::mutex::scoped_lock lock(thread_profiles_mutex);
+        thread_profile = new ThreadProfile(thread_profiles.size());
+        thread_profiles.push_back(thread_profile);
+    }
+    return *thread_profile;
+}
+
+
+void enter(const Phase phase)
+{
+    ThreadProfile &profile = get_thread_profile();
+
+    int child = profile.nodes[profile.current_node].children[phase];
+    if(child < 0)
+    {
+        child = profile.nodes.size();
+        profile.nodes.push_back(ProfileNode(phase, profile.current_node));
+        profile.nodes[profile.current_node].children[phase] = child;
+    }
+
+    profile.current_node = child;
+    profile.start_times.push_back(now_ns());
+    return;
+}
+
+
+void leave()
+{
+    const uint64_t end_ns = now_ns();
+    ThreadProfile &profile = get_thread_profile();
+
+    // called from ~ScopedPhase, must not throw
+    assert(not profile.start_times.empty());
+    if(profile.start_times.empty())
+    {
+        return;
+    }
+
+    const uint64_t start_ns = profile.start_times.back();
+    const uint64_t duration_ns = end_ns - start_ns;
+    profile.start_times.pop_back();
+
+    ProfileNode &node = profile.nodes[profile.current_node];
+    node.num_calls += 1;
+    node.total_ns += duration_ns;
+    node.min_ns = std::min(node.min_ns, duration_ns);
+    node.max_ns = std::max(node.max_ns, duration_ns);
+
+    if(tracing_enabled and profile.events.size() < max_trace_events)
+    {
+        TraceEvent event;
+        event.phase = node.phase;
+        event.start_ns = start_ns;
+        event.duration_ns = duration_ns;
+        profile.events.push_back(event);
+    }
+
+    profile.current_node = node.parent;
+    return;
+}
+
+
+void enable_tracing(const size_t max_events)
+{
+    boost::mutex::scoped_lock lock(thread_profiles_mutex);
+    tracing_enabled = true;
+    max_trace_events = max_events;
+    return;
+}
+
+
+void reset()
+{
+    boost::mutex::scoped_lock lock(thread_profiles_mutex);
+    for(size_t t = 0; t < thread_profiles.size(); t++)
+    {
+        thread_profiles[t]->clear();
+    }
+    return;
+}
+
+
+/// Write the sub-tree rooted at node_index
+void write_json_node(std::ostream &out, const ThreadProfile &profile,
+                     const int node_index, const std::string &indentation)
+{
+    const ProfileNode &node = profile.nodes[node_index];
+
+    uint64_t children_ns = 0;
+    for(int p = 0; p < num_phases; p++)
+    {
+        if(node.children[p] >= 0)
+        {
+            children_ns += profile.nodes[node.children[p]].total_ns;
+        }
+    }
+
+    out << indentation << "{\"phase\": \"" << phase_name(node.phase) << "\", "
+        << "\"calls\": " << node.num_calls << ", "
+        << "\"total_ms\": " << node.total_ns*1e-6 << ", "
+        << "\"self_ms\": " << (node.total_ns - std::min(node.total_ns, children_ns))*1e-6 << ", "
+        << "\"mean_us\": " << (node.num_calls > 0? node.total_ns*1e-3/node.num_calls : 0.0) << ", "
+        << "\"min_us\": " << (node.num_calls > 0? node.min_ns*1e-3 : 0.0) << ", "
+        << "\"max_us\": " << node.max_ns*1e-3 << ", "
+        << "\"children\": [";
+
+    bool first_child = true;
+    for(int p = 0; p < num_phases; p++)
+    {
+        if(node.children[p] >= 0)
+        {
+            out << (first_child? "\n" : ",\n");
+            write_json_node(out, profile, node.children[p], indentation + "  ");
+            first_child = false;
+        }
+    }
+
+    out << "]}";
+    return;
+}
+
+
+void write_json(const std::string &filename)
+{
+    std::ofstream out(filename.c_str());
+    if(not out)
+    {
+        std::stringstream error_message;
+        error_message << "Could not open the profile file " << filename;
+        throw std::runtime_error(error_message.str());
+    }
+
+    out << std::fixed;
+    out.precision(3);
+
+    boost::mutex::scoped_lock lock(thread_profiles_mutex);
+
+#if defined(USE_PROFILER)
+    const bool enabled = true;
+#else
+    const bool enabled = false;
+#endif
+
+    // total time per phase, summed over threads and call paths
+    std::vector<uint64_t> phase_total_ns(num_phases, 0);
+    std::vector<uint64_t> phase_calls(num_phases, 0);
+
+    out << "{\"enabled\": " << (enabled? "true" : "false") << ",\n";
+    out << " \"threads\": [";
+    for(size_t t = 0; t < thread_profiles.size(); t++)
+    {
+        const ThreadProfile &profile = *thread_profiles[t];
+        for(size_t n = 1; n < profile.nodes.size(); n++)
+        {
+            phase_total_ns[profile.nodes[n].phase] += profile.nodes[n].total_ns;
+            phase_calls[profile.nodes[n].phase] += profile.nodes[n].num_calls;
+        }
+
+        out << (t == 0? "\n" : ",\n");
+        out << "  {\"thread\": " << profile.thread_index << ", \"phases\": [";
+        const ProfileNode &root = profile.nodes[0];
+        bool first_child = true;
+        for(int p = 0; p < num_phases; p++)
+        {
+            if(root.children[p] >= 0)
+            {
+                out << (first_child? "\n" : ",\n");
+                write_json_node(out, profile, root.children[p], "    ");
+                first_child = false;
+            }
+        }
+        out << "]}";
+    }
+    out << "],\n";
+
+    out << " \"totals\": {";
+    for(int p = 0; p < num_phases; p++)
+    {
+        out << (p == 0? "\n" : ",\n");
+        out << "  \"" << phase_name(static_cast<Phase>(p)) << "\": {"
+            << "\"calls\": " << phase_calls[p] << ", "
+            << "\"total_ms\": " << phase_total_ns[p]*1e-6 << "}";
+    }
+    out << "}\n}" << std::endl;
+
+    return;
+}
+
+
+void write_chrome_trace(const std::string &filename)
+{
+    std::ofstream out(filename.c_str());
+    if(not out)
+    {
+        std::stringstream error_message;
+        error_message << "Could not open the trace file " << filename;
+        throw std::runtime_error(error_message.str());
+    }
+
+    out << std::fixed;
+    out.precision(3);
+
+    boost::mutex::scoped_lock lock(thread_profiles_mutex);
+
+    uint64_t origin_ns = std::numeric_limits<uint64_t>::max();
+    for(size_t t = 0; t < thread_profiles.size(); t++)
+    {
+        const std::vector<TraceEvent> &events = thread_profiles[t]->events;
+        for(size_t e = 0; e < events.size(); e++)
+        {
+            origin_ns = std::min(origin_ns, events[e].start_ns);
+        }
+    }
+
+    // timestamps are in microseconds
+    out << "{\"traceEvents\": [";
+    bool first_event = true;
+    for(size_t t = 0; t < thread_profiles.size(); t++)
+    {
+        const ThreadProfile &profile = *thread_profiles[t];
+        for(size_t e = 0; e < profile.events.size(); e++)
+        {
+            const TraceEvent &event = profile.events[e];
+            out << (first_event? "\n" : ",\n");
+            out << "{\"name\": \"" << phase_name(event.phase) << "\", "
+                << "\"cat\": \"boosting\", \"ph\": \"X\", "
+                << "\"ts\": " << (event.start_ns - origin_ns)*1e-3 << ", "
+                << "\"dur\": " << event.duration_ns*1e-3 << ", "
+                << "\"pid\": 1, \"tid\": " << profile.thread_index << "}";
+            first_event = false;
+        }
+    }
+    out << "],\n\"displayTimeUnit\": \"ms\"}" << std::endl;
+
+    return;
+}
+
+} // end of namespace Profiler
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,98 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_PROFILER_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_PROFILER_HPP
+
+// Hierarchical phase profiler.
+//
+// Usage:
+//   {
+//       PROFILE_SCOPE(Profiler::solver_function);
+//       ... code to measure ...
+//   }
+//
+// Scopes nest, the time of each phase is aggregated per thread and per
+// call path (e.g. distribution_update/solver_function).
+// The profiler is only compiled in when USE_PROFILER is defined,
+// otherwise PROFILE_SCOPE expands to nothing and has zero overhead.
+// Defining PROFILER_USE_TSC reads the time stamp counter instead of
+// the monotonic clock (lower overhead, requires an invariant TSC).
+
+#include <string>
+#include <stdint.h>
+
+namespace totally_corrective_boosting
+{
+
+namespace Profiler
+{
+
+/// The phases we keep track of
+enum Phase
+{
+    oracle_scan = 0,
+    oracle_sort,
+    ensemble_update,
+    distribution_update,
+    solver_function,
+    solver_gradient,
+    projection,
+    evaluation,
+    num_phases
+};
+
+const char *phase_name(const Phase phase);
+
+/// Nanoseconds since an arbitrary origin (monotonic clock, or TSC if PROFILER_USE_TSC)
+uint64_t now_ns();
+
+/// Open a new phase nested inside the current one (of the calling thread)
+void enter(const Phase phase);
+
+/// Close the current phase of the calling thread (an unmatched call
+/// does nothing)
+void leave();
+
+/// Keep the individual events (up to max_events per thread),
+/// needed to export Chrome traces
+void enable_tracing(const size_t max_events = 1000000);
+
+/// Forget all the measurements done so far, the phases still open
+/// stay open and are measured from the reset on
+void reset();
+
+/// Aggregated per thread call trees, as JSON
+void write_json(const std::string &filename);
+
+/// Chrome trace event format, to be loaded in chrome://tracing or Perfetto
+void write_chrome_trace(const std::string &filename);
+
+/// Scope guard that measures the enclosing block
+class ScopedPhase
+{
+public:
+    explicit ScopedPhase(const Phase phase)
+    {
+        enter(phase);
+    }
+
+    ~ScopedPhase()
+    {
+        leave();
+    }
+};
+
+} // end of namespace Profiler
+
+} // end of namespace totally_corrective_boosting
+
+
+#define PROFILER_CONCATENATE_DETAIL(a, b) a ## b
+#define PROFILER_CONCATENATE(a, b) PROFILER_CONCATENATE_DETAIL(a, b)
+
+#if defined(USE_PROFILER)
+#define PROFILE_SCOPE(phase) \
+    totally_corrective_boosting::Profiler::ScopedPhase PROFILER_CONCATENATE(profiler_scoped_phase_, __LINE__)(phase)
+#else
+#define PROFILE_SCOPE(phase)
+#endif
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_PROFILER_HPP
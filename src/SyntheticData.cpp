@@ -0,0 +1,289 @@
+#include "SyntheticData.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+
+/// splitmix64, small and fast: one generator per example
+class RandomStream
+{
+protected:
+    uint64_t state;
+
+public:
+    explicit RandomStream(const uint64_t seed): state(seed)
+    {
+        // nothing to do here
+    }
+
+    uint64_t next()
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /// uniform in [0, 1)
+    double uniform()
+    {
+        return (next() >> 11)*(1.0/9007199254740992.0);
+    }
+
+    /// number of failures before the first success of probability p
+    double geometric(const double p)
+    {
+        return std::floor(std::log(1.0 - uniform())/std::log(1.0 - p));
+    }
+};
+
+/// Streams of the random numbers of an example
+enum Stream
+{
+    duplicate_stream = 0,
+    features_stream,
+    noise_stream,
+    model_stream
+};
+
+} // end of anonymous namespace
+
+
+SyntheticDataSettings::SyntheticDataSettings()
+    : num_examples(1000),
+      num_features(100),
+      density(0.1),
+      density_distribution("uniform"),
+      zipf_exponent(1.0),
+      binary_features(false),
+      label_noise(0),
+      duplicate_fraction(0),
+      seed(1)
+{
+    // nothing to do here
+}
+
+
+void SyntheticDataSettings::read(const ConfigFile &config, const std::string &prefix)
+{
+    config.readInto(num_examples, prefix + "N", num_examples);
+    config.readInto(num_features, prefix + "D", num_features);
+    config.readInto(density, prefix + "density", density);
+    config.readInto(density_distribution, prefix + "density_distribution", density_distribution);
+    config.readInto(zipf_exponent, prefix + "zipf_exponent", zipf_exponent);
+    config.readInto(binary_features, prefix + "binary_features", binary_features);
+    config.readInto(label_noise, prefix + "label_noise", label_noise);
+    config.readInto(duplicate_fraction, prefix + "duplicate_fraction", duplicate_fraction);
+    config.readInto(seed, prefix + "seed", seed);
+    return;
+}
+
+
+SyntheticDataGenerator::SyntheticDataGenerator(const SyntheticDataSettings &settings_)
+    : settings(settings_),
+      feature_density(settings_.num_features),
+      feature_weight(settings_.num_features),
+      margin_offset(0)
+{
+    if(settings.density < 0 or settings.density > 1)
+    {
+        std::stringstream os;
+        os << "SyntheticDataGenerator: density must be in [0, 1], got " << settings.density;
+        throw std::invalid_argument(os.str());
+    }
+
+    if(settings.density_distribution != "uniform" and settings.density_distribution != "zipf")
+    {
+        std::stringstream os;
+        os << "SyntheticDataGenerator: unknown density_distribution " << settings.density_distribution
+           << " (uniform or zipf)";
+        throw std::invalid_argument(os.str());
+    }
+
+    const double mean_value = settings.binary_features? 1.0 : 0.5;
+
+    RandomStream random(stream_seed(0, model_stream));
+    for(size_t j = 0; j < settings.num_features; j++)
+    {
+        if(settings.density_distribution == "zipf")
+        {
+            feature_density[j] = settings.density/std::pow(j + 1.0, settings.zipf_exponent);
+        }
+        else
+        {
+            feature_density[j] = settings.density;
+        }
+
+        // Box-Muller
+        const double radius = std::sqrt(-2.0*std::log(1.0 - random.uniform()));
+        feature_weight[j] = radius*std::cos(2.0*M_PI*random.uniform());
+
+        margin_offset += feature_density[j]*mean_value*feature_weight[j];
+    }
+
+    for(size_t begin = 0, size = 1; begin < settings.num_features; begin += size, size *= 2)
+    {
+        const size_t end = std::min(begin + size, settings.num_features);
+        block_begin.push_back(begin);
+        block_density.push_back(*std::max_element(feature_density.begin() + begin,
+                                                  feature_density.begin() + end));
+    }
+    block_begin.push_back(settings.num_features);
+
+    return;
+}
+
+
+uint64_t SyntheticDataGenerator::stream_seed(const size_t row, const uint64_t stream) const
+{
+    RandomStream random((uint64_t(settings.seed) << 32) ^ (uint64_t(row)*4 + stream));
+    return random.next();
+}
+
+
+size_t SyntheticDataGenerator::get_num_features() const
+{
+    return settings.num_features + 1;
+}
+
+
+size_t SyntheticDataGenerator::source_row(const size_t row) const
+{
+    // the test rows only copy test rows, so that no training example leaks
+    // into the test set
+    const size_t split_begin = (row < settings.num_examples)? 0 : settings.num_examples;
+
+    size_t source = row;
+    while(source > split_begin)
+    {
+        RandomStream random(stream_seed(source, duplicate_stream));
+        if(random.uniform() >= settings.duplicate_fraction)
+        {
+            break;
+        }
+        source = split_begin + random.next() % (source - split_begin);
+    }
+    return source;
+}
+
+
+double SyntheticDataGenerator::generate_features(const size_t row,
+                                                 std::vector<size_t> &indices,
+                                                 std::vector<double> &values) const
+{
+    indices.clear();
+    values.clear();
+
+    RandomStream random(stream_seed(row, features_stream));
+
+    double margin = 0;
+    for(size_t b = 0; b + 1 < block_begin.size(); b++)
+    {
+        const double max_density = block_density[b];
+        if(max_density <= 0)
+        {
+            continue;
+        }
+
+        const size_t end = block_begin[b + 1];
+        size_t j = block_begin[b];
+        while(true)
+        {
+            if(max_density < 1)
+            {
+                const double skip = random.geometric(max_density);
+                if(skip >= double(end - j))
+                {
+                    break;
+                }
+                j += size_t(skip);
+            }
+            if(j >= end)
+            {
+                break;
+            }
+
+            if(random.uniform()*max_density < feature_density[j])
+            {
+                const double value = settings.binary_features? 1.0 : 1.0 - random.uniform();
+                indices.push_back(j + 1);
+                values.push_back(value);
+                margin += feature_weight[j]*value;
+            }
+            j++;
+        }
+    }
+
+    return margin;
+}
+
+
+void SyntheticDataGenerator::generate_row(const size_t row, int &label,
+                                          std::vector<size_t> &indices,
+                                          std::vector<double> &values) const
+{
+    const double margin = generate_features(source_row(row), indices, values);
+    label = (margin > margin_offset)? 1 : -1;
+
+    RandomStream random(stream_seed(row, noise_stream));
+    if(random.uniform() < settings.label_noise)
+    {
+        label = -label;
+    }
+    return;
+}
+
+
+void SyntheticDataGenerator::generate_transpose(const size_t first_row, const size_t num_rows,
+                                                std::vector<SparseVector> &data,
+                                                std::vector<int> &labels) const
+{
+    std::vector<size_t> indices;
+    std::vector<double> values;
+
+    // first pass, count the non zeros of each feature
+    std::vector<size_t> feature_nnz(get_num_features(), 0);
+    labels.resize(num_rows);
+    for(size_t i = 0; i < num_rows; i++)
+    {
+        generate_row(first_row + i, labels[i], indices, values);
+        for(size_t k = 0; k < indices.size(); k++)
+        {
+            feature_nnz[indices[k]] += 1;
+        }
+    }
+
+    data.clear();
+    data.resize(get_num_features());
+    for(size_t j = 0; j < data.size(); j++)
+    {
+        data[j].resize(num_rows, feature_nnz[j]);
+    }
+
+    // second pass, fill
+    std::fill(feature_nnz.begin(), feature_nnz.end(), 0);
+    int label = 0;
+    for(size_t i = 0; i < num_rows; i++)
+    {
+        generate_row(first_row + i, label, indices, values);
+        for(size_t k = 0; k < indices.size(); k++)
+        {
+            SparseVector &feature = data[indices[k]];
+            feature.index[feature_nnz[indices[k]]] = i;
+            feature.val[feature_nnz[indices[k]]] = values[k];
+            feature_nnz[indices[k]] += 1;
+        }
+    }
+
+    return;
+}
+
+} // end of namespace totally_corrective_boosting
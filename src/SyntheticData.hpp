@@ -0,0 +1,111 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_SYNTHETICDATA_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_SYNTHETICDATA_HPP
+
+#include "math/sparse_vector.hpp"
+#include "ConfigFile.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Parameters of a synthetic sparse dataset
+class SyntheticDataSettings
+{
+public:
+
+    size_t num_examples;
+    size_t num_features;
+
+    /// Probability for an entry to be non zero: the same for all the features
+    /// ("uniform"), or density/(j+1)^zipf_exponent for feature j ("zipf")
+    double density;
+    std::string density_distribution;
+    double zipf_exponent;
+
+    /// Non zero entries are 1, or uniform in (0, 1]
+    bool binary_features;
+
+    /// Probability to flip the label of an example
+    double label_noise;
+
+    /// Probability for an example to be a copy of a previous one
+    double duplicate_fraction;
+
+    unsigned int seed;
+
+    SyntheticDataSettings();
+
+    /// Keys are N, D, density, density_distribution, zipf_exponent,
+    /// binary_features, label_noise, duplicate_fraction and seed,
+    /// each preceded by prefix
+    void read(const ConfigFile &config, const std::string &prefix = "");
+};
+
+
+/// Generates examples of a sparse binary classification problem.
+///
+/// The labels are given by a hidden linear model of the features (then
+/// flipped with probability label_noise). Every example is generated from
+/// its own random stream, so examples can be generated one at a time and
+/// in any order: datasets much larger than the memory can be streamed to
+/// disk, and the rows [N, N + test examples) give a test set from the same
+/// distribution. Only O(D) memory is used by the generator itself.
+///
+/// Feature indices start at 1 (LibSVM convention), so the transposed data
+/// has D + 1 features, the first one being empty, as with readlibSVM_transpose.
+class SyntheticDataGenerator
+{
+
+protected:
+
+    const SyntheticDataSettings settings;
+
+    std::vector<double> feature_density;
+
+    /// Hidden linear model, and its expected margin
+    std::vector<double> feature_weight;
+    double margin_offset;
+
+    /// Features are grouped in blocks of doubling sizes, the non zeros of
+    /// a block are sampled by geometric skips with the largest density of
+    /// the block (then accepted with the density of the feature)
+    std::vector<size_t> block_begin;
+    std::vector<double> block_density;
+
+    uint64_t stream_seed(const size_t row, const uint64_t stream) const;
+
+    /// Row whose features are copied by row (row itself if not a duplicate),
+    /// always an earlier row of the same split (training rows [0, N), test rows
+    /// from N on)
+    size_t source_row(const size_t row) const;
+
+    /// Features of the row (no duplicates, no label noise), returns the margin
+    double generate_features(const size_t row,
+                             std::vector<size_t> &indices,
+                             std::vector<double> &values) const;
+
+public:
+
+    SyntheticDataGenerator(const SyntheticDataSettings &settings);
+
+    /// Dimension of the transposed data (D + 1)
+    size_t get_num_features() const;
+
+    /// Label and (sorted) non zero features of an example
+    void generate_row(const size_t row, int &label,
+                      std::vector<size_t> &indices,
+                      std::vector<double> &values) const;
+
+    /// Examples [first_row, first_row + num_rows), transposed as by readlibSVM_transpose
+    void generate_transpose(const size_t first_row, const size_t num_rows,
+                            std::vector<SparseVector> &data,
+                            std::vector<int> &labels) const;
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_SYNTHETICDATA_HPP
@@ -35,15 +35,19 @@ Timer::~Timer()
     return;
 }
 
-void Timer::start()
+/// Seconds elapsed on the given clock (nanoseconds resolution)
+double clock_seconds(const clockid_t clock_id)
 {
-    struct tms start;
-    times(&start);
-    _start_cpu = (double(start.tms_utime) + double(start.tms_stime))/TIMES_TICKS_PER_SEC;
+    timespec ts;
+    clock_gettime(clock_id, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec)/1e9;
+}
+
 
-    timeval wc;
-    gettimeofday(&wc, NULL);
-    _start_wall_clock = double(wc.tv_sec) + double(wc.tv_usec)/1e6;
+void Timer::start()
+{
+    _start_cpu = clock_seconds(CLOCK_PROCESS_CPUTIME_ID);
+    _start_wall_clock = clock_seconds(CLOCK_MONOTONIC);
     return;
 }
 
@@ -58,18 +62,14 @@ void Timer::stop()
         throw std::runtime_error(os.str());
     }
 
-    struct tms end;
-    times(&end);
-    last_cpu = (double(end.tms_utime) + double(end.tms_stime))/TIMES_TICKS_PER_SEC - _start_cpu;
+    last_cpu = clock_seconds(CLOCK_PROCESS_CPUTIME_ID) - _start_cpu;
 
     _start_cpu = -1;
     total_cpu += last_cpu;
     max_cpu = std::max(max_cpu, last_cpu);
     min_cpu = std::min(min_cpu, last_cpu);
 
-    timeval wc;
-    gettimeofday(&wc, NULL);
-    last_wall_clock = (double(wc.tv_sec) + double(wc.tv_usec)/1e6) - _start_wall_clock;
+    last_wall_clock = clock_seconds(CLOCK_MONOTONIC) - _start_wall_clock;
 
     _start_wall_clock = -1;
     total_wall_clock += last_wall_clock;
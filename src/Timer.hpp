@@ -4,24 +4,13 @@
 #define _TIMER_HPP_
 
 #include <time.h>
-#include <sys/time.h>
-#include <sys/param.h>
-#include <sys/times.h>
-#include <sys/types.h>
-
-
-#if defined(CLK_TCK)
-#define TIMES_TICKS_PER_SEC double(CLK_TCK)
-#elif defined(_SC_CLK_TCK)
-#define TIMES_TICKS_PER_SEC double(sysconf(_SC_CLK_TCK))
-#elif defined(HZ)
-#define TIMES_TICKS_PER_SEC double(HZ)
-#endif
 
 namespace totally_corrective_boosting
 {
 
-/// Keep track of CPU and wall-clock time (in seconds) of program segments
+/// Keep track of CPU and wall-clock time (in seconds) of program segments.
+/// Uses the process CPU time and monotonic clocks (nanoseconds resolution),
+/// see Profiler.hpp for a per phase breakdown
 class Timer
 {
 
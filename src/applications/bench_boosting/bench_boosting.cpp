@@ -0,0 +1,529 @@
+
+#include "LibSvmReader.hpp"
+
+#include "oracles/oracles_factory.hpp"
+
+#include "boosters/AbstractBooster.hpp"
+#include "boosters/boosters_factory.hpp"
+
+#include "EvaluateLoss.hpp"
+#include "ConfigFile.hpp"
+#include "MetricsWriter.hpp"
+#include "MemoryUsage.hpp"
+#include "SyntheticData.hpp"
+#include "Timer.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <omp.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace totally_corrective_boosting;
+
+
+/// One cell of the benchmark matrix
+class BenchmarkRun
+{
+public:
+    std::string dataset, booster, optimizer, oracle;
+    int threads;
+
+    /// Identifies the run across benchmark executions
+    std::string key() const
+    {
+        std::stringstream key_stream;
+        key_stream << dataset << "|" << booster << "|" << optimizer << "|" << oracle << "|" << threads;
+        return key_stream.str();
+    }
+
+    /// Same as key(), ignoring the number of threads
+    std::string sequential_key() const
+    {
+        return dataset + "|" + booster + "|" + optimizer + "|" + oracle;
+    }
+};
+
+
+/// Split a white space separated list of values
+std::vector<std::string> split_values(const std::string &values)
+{
+    std::vector<std::string> result;
+    std::istringstream values_stream(values);
+    std::string value;
+    while(values_stream >> value)
+    {
+        result.push_back(value);
+    }
+    return result;
+}
+
+
+/// Position of the quote closing the JSON string that starts after begin,
+/// the escaped characters are skipped
+size_t find_closing_quote(const std::string &line, size_t begin)
+{
+    while(begin < line.size() and line[begin] != '"')
+    {
+        begin += (line[begin] == '\\')? 2 : 1;
+    }
+    return (begin < line.size())? begin : std::string::npos;
+}
+
+
+/// Parse one line of flat JSON ({"key": value, ...}, no nesting),
+/// string values are returned without their quotes (and still escaped)
+std::map<std::string, std::string> parse_json_line(const std::string &line)
+{
+    std::map<std::string, std::string> fields;
+
+    size_t position = 0;
+    while(true)
+    {
+        const size_t key_begin = line.find('"', position);
+        if(key_begin == std::string::npos)
+        {
+            break;
+        }
+        const size_t key_end = find_closing_quote(line, key_begin + 1);
+        const size_t colon = line.find(':', key_end);
+        if(key_end == std::string::npos or colon == std::string::npos)
+        {
+            break;
+        }
+
+        size_t value_begin = line.find_first_not_of(' ', colon + 1);
+        size_t value_end = 0;
+        if(line[value_begin] == '"')
+        {
+            value_begin += 1;
+            value_end = find_closing_quote(line, value_begin);
+            position = value_end + 1;
+        }
+        else
+        {
+            value_end = line.find_first_of(",}", value_begin);
+            position = value_end;
+        }
+
+        fields[line.substr(key_begin + 1, key_end - key_begin - 1)] = line.substr(value_begin, value_end - value_begin);
+    }
+
+    return fields;
+}
+
+
+/// Returns the value of the record, or null when not defined (NaN or infinite)
+std::string json_value(const double value)
+{
+    if(is_undefined_value(value))
+    {
+        return "null";
+    }
+    std::stringstream value_stream;
+    value_stream.precision(10);
+    value_stream << value;
+    return value_stream.str();
+}
+
+
+/// value as a JSON string, with its quotes
+std::string json_string(const std::string &value)
+{
+    std::stringstream string_stream;
+    string_stream << '"';
+    for(size_t i = 0; i < value.size(); i++)
+    {
+        const char c = value[i];
+        if(c == '"' or c == '\\')
+        {
+            string_stream << '\\' << c;
+        }
+        else if(c == '\n')
+        {
+            string_stream << "\\n";
+        }
+        else if(c == '\t')
+        {
+            string_stream << "\\t";
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::sprintf(escaped, "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+            string_stream << escaped;
+        }
+        else
+        {
+            string_stream << c;
+        }
+    }
+    string_stream << '"';
+    return string_stream.str();
+}
+
+
+/// Runs a single cell of the matrix, in the current process
+std::string run_benchmark(const ConfigFile &base_config, const BenchmarkRun &run)
+{
+    ConfigFile config(base_config);
+    config.add("booster_type", run.booster);
+    config.add("optimizer_type", run.optimizer);
+    config.add("oracle_type", run.oracle);
+
+    double epsilon = 0;
+    config.readInto(epsilon, "eps", 0.001);
+
+    omp_set_num_threads(run.threads);
+
+    std::vector<SparseVector> data, test_data;
+    std::vector<int> labels, test_labels;
+    const bool transposed = true;
+    if(config.keyExists(run.dataset + "_N"))
+    {
+        // synthetic, the test examples follow the training ones
+        SyntheticDataSettings data_settings;
+        data_settings.read(config, run.dataset + "_");
+
+        size_t num_test_examples = 0;
+        config.readInto(num_test_examples, run.dataset + "_test_N", data_settings.num_examples/4);
+
+        const SyntheticDataGenerator generator(data_settings);
+        generator.generate_transpose(0, data_settings.num_examples, data, labels);
+        generator.generate_transpose(data_settings.num_examples, num_test_examples, test_data, test_labels);
+    }
+    else
+    {
+        std::string train_filepath, test_filepath;
+        config.readInto(train_filepath, run.dataset + "_train");
+        config.readInto(test_filepath, run.dataset + "_test");
+
+        LibSVMReader svm_reader;
+        svm_reader.read_transpose(train_filepath, data, labels);
+        svm_reader.read_transpose(test_filepath, test_data, test_labels);
+    }
+    while(test_data.size() < data.size())
+    {
+        SparseVector empty(data[0].dim, 1);
+        test_data.push_back(empty);
+    }
+
+    std::ofstream null_stream("/dev/null");
+
+    boost::shared_ptr<AbstractOracle> oracle( new_oracle_instance(config, data, labels, transposed, null_stream) );
+    boost::shared_ptr<AbstractBooster> ensemble_booster( new_booster_instance(config, labels, oracle, null_stream) );
+    boost::shared_ptr<MetricsRecorder> recorder(new MetricsRecorder());
+    ensemble_booster->set_metrics_writer(recorder);
+
+    Timer timer;
+    timer.start();
+    ensemble_booster->boost(null_stream);
+    timer.stop();
+
+    // time to reach the epsilon gap, and split of the time
+    double oracle_time = 0, solver_time = 0, elapsed_time = 0;
+    double time_to_gap = std::numeric_limits<double>::quiet_NaN();
+    double final_gap = std::numeric_limits<double>::quiet_NaN();
+    bool gap_reached = false;
+    for(size_t r = 0; r < recorder->records.size(); r++)
+    {
+        const IterationRecord &record = recorder->records[r];
+        oracle_time += record.oracle_time;
+        solver_time += record.solver_time;
+        elapsed_time += record.iteration_time;
+        final_gap = record.gap;
+        if(record.gap <= epsilon and not gap_reached)
+        {
+            time_to_gap = elapsed_time;
+            gap_reached = true;
+        }
+    }
+
+    EvaluateLoss score;
+    const DenseVector test_predictions = ensemble_booster->get_ensemble().predict(test_data);
+    int test_loss = 0;
+    double test_error = 0;
+    score.binary_loss(test_predictions, test_labels, test_loss, test_error);
+
+    std::stringstream result;
+    result << "\"status\": \"ok\", "
+           << "\"iterations\": " << ensemble_booster->get_num_iterations() << ", "
+           << "\"converged\": " << (recorder->records.empty() or not recorder->records.back().converged? "false" : "true") << ", "
+           << "\"total_time\": " << json_value(timer.last_wall_clock) << ", "
+           << "\"oracle_time\": " << json_value(oracle_time) << ", "
+           << "\"solver_time\": " << json_value(solver_time) << ", "
+           << "\"time_to_gap\": " << json_value(time_to_gap) << ", "
+           << "\"final_gap\": " << json_value(final_gap) << ", "
+           << "\"peak_rss\": " << peak_resident_memory_bytes() << ", "
+           << "\"test_error\": " << json_value(test_error);
+    return result.str();
+}
+
+
+/// Runs a cell of the matrix in a child process,
+/// so that crashes are reported and the peak memory is measured per run
+std::string run_benchmark_in_child(const ConfigFile &config, const BenchmarkRun &run,
+                                   const std::string &result_filepath)
+{
+    std::remove(result_filepath.c_str());
+
+    const pid_t pid = fork();
+    if(pid < 0)
+    {
+        throw std::runtime_error("bench_boosting could not fork");
+    }
+
+    if(pid == 0)
+    {
+        // child process, the boosters are chatty
+        if(std::freopen("/dev/null", "w", stdout) == NULL)
+        {
+            _exit(EXIT_FAILURE);
+        }
+
+        int exit_status = EXIT_SUCCESS;
+        std::string result;
+        try
+        {
+            result = run_benchmark(config, run);
+        }
+        catch(const std::exception &e)
+        {
+            result = std::string("\"status\": \"failed\", \"error\": ") + json_string(e.what());
+            exit_status = EXIT_FAILURE;
+        }
+
+        std::ofstream result_stream(result_filepath.c_str());
+        result_stream << result << std::endl;
+        result_stream.close();
+        _exit(exit_status);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    std::ifstream result_stream(result_filepath.c_str());
+    std::string result;
+    std::getline(result_stream, result);
+    result_stream.close();
+    std::remove(result_filepath.c_str());
+
+    if(result.empty())
+    {
+        std::stringstream failure;
+        failure << "\"status\": \"crashed\", \"exit_status\": " << status;
+        result = failure.str();
+    }
+
+    return result;
+}
+
+
+/// Compare against a previous output of bench_boosting
+/// @returns the number of regressions
+int compare_with_baseline(const std::string &baseline_filepath,
+                          const std::vector<std::map<std::string, std::string> > &results,
+                          const double regression_threshold,
+                          std::ostream &log_stream)
+{
+    std::ifstream baseline_stream(baseline_filepath.c_str());
+    if(not baseline_stream.good())
+    {
+        std::stringstream os;
+        os << "Cannot open baseline file : " << baseline_filepath << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    std::map<std::string, std::map<std::string, std::string> > baseline;
+    std::string line;
+    while(std::getline(baseline_stream, line))
+    {
+        std::map<std::string, std::string> fields = parse_json_line(line);
+        if(fields.count("key"))
+        {
+            baseline[fields["key"]] = fields;
+        }
+    }
+
+    const char *compared_fields[] = {"total_time", "time_to_gap", "peak_rss"};
+    const size_t num_compared_fields = sizeof(compared_fields)/sizeof(compared_fields[0]);
+
+    int num_regressions = 0;
+    log_stream << "Comparison with " << baseline_filepath
+               << " (ratios new/baseline, regression above " << regression_threshold << ")" << std::endl;
+    for(size_t r = 0; r < results.size(); r++)
+    {
+        std::map<std::string, std::string> result = results[r];
+        if(not baseline.count(result["key"]))
+        {
+            log_stream << "    " << result["key"] << ": not in the baseline" << std::endl;
+            continue;
+        }
+
+        std::map<std::string, std::string> &reference = baseline[result["key"]];
+        log_stream << "    " << result["key"] << ":";
+        for(size_t f = 0; f < num_compared_fields; f++)
+        {
+            const std::string field = compared_fields[f];
+            const double new_value = std::atof(result[field].c_str());
+            const double reference_value = std::atof(reference[field].c_str());
+            if(result[field] == "null" or reference[field] == "null" or reference_value <= 0)
+            {
+                continue;
+            }
+
+            const double ratio = new_value/reference_value;
+            log_stream << " " << field << " " << ratio;
+            if(ratio > regression_threshold)
+            {
+                log_stream << " (REGRESSION)";
+                num_regressions += 1;
+            }
+        }
+
+        if(result["test_error"] != reference["test_error"])
+        {
+            log_stream << " test_error " << reference["test_error"] << " -> " << result["test_error"];
+        }
+        log_stream << std::endl;
+    }
+
+    log_stream << num_regressions << " regression(s)" << std::endl;
+    return num_regressions;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        std::stringstream os;
+        os <<"You need to run this program as: bench_boosting name_of_config_file"
+          << std::endl
+          << "See bench_boosting.config.ini for an example"
+          << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    ConfigFile config(argv[1]);
+
+    std::string datasets, boosters, optimizers, oracles, threads;
+    config.readInto(datasets, "datasets", std::string("a9a"));
+    config.readInto(boosters, "boosters", std::string("ERLPBoost tKlBoost AdaBoost Corrective"));
+    config.readInto(optimizers, "optimizers", std::string("lbfgsb pg hz cd"));
+    config.readInto(oracles, "oracles", std::string("decisionstump rawdata svm"));
+    config.readInto(threads, "threads", std::string("1"));
+
+    std::string output_filepath, baseline_filepath;
+    config.readInto(output_filepath, "output_file", std::string("bench_boosting.jsonl"));
+    config.readInto(baseline_filepath, "baseline_file", std::string());
+
+    double regression_threshold = 1.1;
+    config.readInto(regression_threshold, "regression_threshold", 1.1);
+
+    // the matrix --
+    std::vector<BenchmarkRun> runs;
+    const std::vector<std::string> dataset_names = split_values(datasets);
+    const std::vector<std::string> booster_names = split_values(boosters);
+    const std::vector<std::string> optimizer_names = split_values(optimizers);
+    const std::vector<std::string> oracle_names = split_values(oracles);
+    const std::vector<std::string> thread_counts = split_values(threads);
+
+    for(size_t d = 0; d < dataset_names.size(); d++)
+    {
+        for(size_t b = 0; b < booster_names.size(); b++)
+        {
+            // only the totally corrective boosters use an optimizer
+            const bool uses_optimizer = (booster_names[b] == "ERLPBoost" or booster_names[b] == "tKlBoost");
+            const std::vector<std::string> booster_optimizers =
+                    uses_optimizer? optimizer_names : std::vector<std::string>(1, "none");
+
+            for(size_t p = 0; p < booster_optimizers.size(); p++)
+            {
+                for(size_t o = 0; o < oracle_names.size(); o++)
+                {
+                    for(size_t t = 0; t < thread_counts.size(); t++)
+                    {
+                        BenchmarkRun run;
+                        run.dataset = dataset_names[d];
+                        run.booster = booster_names[b];
+                        run.optimizer = booster_optimizers[p];
+                        run.oracle = oracle_names[o];
+                        run.threads = std::atoi(thread_counts[t].c_str());
+                        runs.push_back(run);
+                    }
+                }
+            }
+        }
+    }
+
+    std::ofstream output_stream(output_filepath.c_str());
+    if(not output_stream.good())
+    {
+        std::stringstream os;
+        os <<"Cannot open output file : " << output_filepath << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    // run them --
+    std::map<std::string, double> sequential_times;
+    std::vector<std::map<std::string, std::string> > results;
+    const std::string result_filepath = output_filepath + ".run";
+
+    for(size_t r = 0; r < runs.size(); r++)
+    {
+        const BenchmarkRun &run = runs[r];
+        std::cout << "[" << r + 1 << "/" << runs.size() << "] " << run.key() << std::flush;
+
+        std::stringstream line;
+        line << "{\"key\": " << json_string(run.key()) << ", "
+             << "\"dataset\": " << json_string(run.dataset) << ", "
+             << "\"booster\": " << json_string(run.booster) << ", "
+             << "\"optimizer\": " << json_string(run.optimizer) << ", "
+             << "\"oracle\": " << json_string(run.oracle) << ", "
+             << "\"threads\": " << run.threads << ", "
+             << run_benchmark_in_child(config, run, result_filepath);
+
+        std::map<std::string, std::string> fields = parse_json_line(line.str() + "}");
+
+        // parallel speedup w.r.t. the first thread count of the sweep
+        if(fields["status"] == "ok")
+        {
+            const double total_time = std::atof(fields["total_time"].c_str());
+            if(not sequential_times.count(run.sequential_key()))
+            {
+                sequential_times[run.sequential_key()] = total_time;
+            }
+            line << ", \"speedup\": " << json_value(sequential_times[run.sequential_key()]/total_time);
+        }
+        line << "}";
+
+        output_stream << line.str() << std::endl;
+        results.push_back(parse_json_line(line.str()));
+
+        std::cout << " " << fields["status"] << " " << fields["total_time"] << " s" << std::endl;
+    }
+    output_stream.close();
+
+    std::cout << "Results written to " << output_filepath << std::endl;
+
+    if(not baseline_filepath.empty())
+    {
+        const int num_regressions = compare_with_baseline(baseline_filepath, results, regression_threshold, std::cout);
+        return (num_regressions > 0)? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    return EXIT_SUCCESS;
+}
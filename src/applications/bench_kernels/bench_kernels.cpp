@@ -0,0 +1,634 @@
+
+#include "math/vector_operations.hpp"
+#include "oracles/DecisionStump.hpp"
+#include "optimizers/LbfgsbOptimizer.hpp"
+#include "optimizers/ProjectedGradientOptimizer.hpp"
+#include "math/simplex_projection.hpp"
+#include "math/capped_softmax.hpp"
+
+#include "ConfigFile.hpp"
+#include "Profiler.hpp"
+#include "SyntheticData.hpp"
+
+#include <cstdlib>
+#include <cmath>
+#include <new>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace totally_corrective_boosting;
+
+
+// ----------------------------------------------------------------------
+// Allocations counting, every operator new of the process goes through here
+
+size_t num_allocations = 0;
+size_t num_allocated_bytes = 0;
+
+void *counted_allocation(const size_t size)
+{
+    __sync_add_and_fetch(&num_allocations, 1);
+    __sync_add_and_fetch(&num_allocated_bytes, size);
+
+    void *pointer = std::malloc(size == 0? 1 : size);
+    if(pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new(size_t size)
+{
+    return counted_allocation(size);
+}
+
+void *operator new[](size_t size)
+{
+    return counted_allocation(size);
+}
+
+void operator delete(void *pointer) throw()
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) throw()
+{
+    std::free(pointer);
+}
+
+
+// ----------------------------------------------------------------------
+// Benchmarked kernels
+
+/// One kernel to benchmark, run() is timed,
+/// elements and bytes describe the work done by a single run()
+class Kernel
+{
+public:
+    std::string name;
+    double elements;
+    double bytes;
+
+    Kernel(const std::string &name_, const double elements_, const double bytes_)
+        : name(name_), elements(elements_), bytes(bytes_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    virtual ~Kernel()
+    {
+        // nothing to do here
+        return;
+    }
+
+    virtual void run() = 0;
+};
+
+
+/// Keeps the results alive so the compiler cannot drop the computation
+double sink = 0;
+
+
+class DenseDotKernel: public Kernel
+{
+    const DenseVector &a, &b;
+public:
+    DenseDotKernel(const DenseVector &a_, const DenseVector &b_)
+        : Kernel("dense_dot", a_.dim, 2.0*a_.dim*sizeof(double)), a(a_), b(b_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        sink += dot(a, b);
+        return;
+    }
+};
+
+
+class DenseAxpyKernel: public Kernel
+{
+    const DenseVector &x, &y;
+    DenseVector result;
+public:
+    DenseAxpyKernel(const DenseVector &x_, const DenseVector &y_)
+        : Kernel("dense_axpy", x_.dim, 3.0*x_.dim*sizeof(double)), x(x_), y(y_), result(x_.dim)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        axpy(0.5, x, y, result);
+        sink += result.val[0];
+        return;
+    }
+};
+
+
+/// Edges of all the (sparse) features, dot(data, distribution)
+class SparseColumnsDotKernel: public Kernel
+{
+    const std::vector<SparseVector> &data;
+    const DenseVector &distribution;
+public:
+    SparseColumnsDotKernel(const std::vector<SparseVector> &data_, const DenseVector &distribution_,
+                           const double nnz)
+        : Kernel("sparse_columns_dot", nnz, nnz*(2*sizeof(double) + sizeof(size_t))),
+          data(data_), distribution(distribution_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        DenseVector result;
+        dot(data, distribution, result);
+        sink += result.val[0];
+        return;
+    }
+};
+
+
+/// Gradient w.r.t. the ensemble weights, dot(U, distribution) with dense columns
+class DenseColumnsDotKernel: public Kernel
+{
+    const std::vector<DenseVector> &columns;
+    const DenseVector &distribution;
+public:
+    DenseColumnsDotKernel(const std::vector<DenseVector> &columns_, const DenseVector &distribution_)
+        : Kernel("dense_columns_dot",
+                 double(columns_.size())*distribution_.dim,
+                 double(columns_.size() + 1)*distribution_.dim*sizeof(double)),
+          columns(columns_), distribution(distribution_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        DenseVector result;
+        dot(columns, distribution, result);
+        sink += result.val[0];
+        return;
+    }
+};
+
+
+/// Ensemble margins, transpose_dot(U, w) with dense columns
+class DenseColumnsTransposeDotKernel: public Kernel
+{
+    const std::vector<DenseVector> &columns;
+    const DenseVector &weights;
+public:
+    DenseColumnsTransposeDotKernel(const std::vector<DenseVector> &columns_, const DenseVector &weights_)
+        : Kernel("dense_columns_transpose_dot",
+                 double(columns_.size())*columns_[0].dim,
+                 double(columns_.size() + 1)*columns_[0].dim*sizeof(double)),
+          columns(columns_), weights(weights_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        DenseVector result;
+        transpose_dot(columns, weights, result);
+        sink += result.val[0];
+        return;
+    }
+};
+
+
+class RelativeEntropyKernel: public Kernel
+{
+    const DenseVector &distribution;
+public:
+    explicit RelativeEntropyKernel(const DenseVector &distribution_)
+        : Kernel("relative_entropy", distribution_.dim, distribution_.dim*sizeof(double)),
+          distribution(distribution_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        sink += relative_entropy(distribution);
+        return;
+    }
+};
+
+
+/// Best threshold of every feature, the core of the DecisionStump oracle
+class StumpScanKernel: public Kernel
+{
+    const DecisionStump &oracle;
+    const DenseVector &distribution;
+    const size_t num_features;
+    const double init_edge;
+public:
+    StumpScanKernel(const DecisionStump &oracle_, const DenseVector &distribution_,
+                    const size_t num_features_, const double nnz, const double init_edge_)
+        : Kernel("stump_scan", nnz,
+                 nnz*(2*sizeof(double) + sizeof(size_t) + sizeof(int))),
+          oracle(oracle_), distribution(distribution_),
+          num_features(num_features_), init_edge(init_edge_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        for(size_t i = 0; i < num_features; i++)
+        {
+            double threshold = 0, edge = 0;
+            bool direction = false;
+            oracle.find_best_threshold(i, distribution, init_edge, threshold, edge, direction);
+            sink += edge;
+        }
+        return;
+    }
+};
+
+
+/// ERLPBoost dual function: margins plus safe softmax
+class ErlpFunctionKernel: public Kernel
+{
+    AbstractOptimizer &optimizer;
+public:
+    ErlpFunctionKernel(AbstractOptimizer &optimizer_, const size_t num_examples, const size_t num_columns)
+        : Kernel("erlp_function", double(num_columns + 1)*num_examples,
+                 double(num_columns + 3)*num_examples*sizeof(double)),
+          optimizer(optimizer_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        sink += optimizer.function();
+        return;
+    }
+};
+
+
+class ErlpGradientKernel: public Kernel
+{
+    AbstractOptimizer &optimizer;
+public:
+    ErlpGradientKernel(AbstractOptimizer &optimizer_, const size_t num_examples, const size_t num_columns)
+        : Kernel("erlp_gradient", double(num_columns + 1)*num_examples,
+                 double(num_columns + 2)*num_examples*sizeof(double)),
+          optimizer(optimizer_)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        DenseVector gradient = optimizer.gradient();
+        sink += gradient.val[0];
+        return;
+    }
+};
+
+
+/// Projection of a pg/hz step onto the ERLPBoost feasible set (T weights on
+/// the simplex, then N psi >= 0) or onto the binary one (beta after the
+/// T weights is free, all the others on the simplex), either as the
+/// general Dai-Fletcher routine is called or with SimplexProjection
+class ProjectionKernel: public Kernel
+{
+    const DenseVector &z;
+    const size_t num_weak_learners;
+    const bool binary, dai_fletcher;
+    DenseVector x;
+    SimplexProjection simplex_projection;
+public:
+    ProjectionKernel(const std::string &name_, const DenseVector &z_, const size_t num_weak_learners_,
+                     const bool binary_, const bool dai_fletcher_)
+        : Kernel(name_, z_.dim, 2.0*z_.dim*sizeof(double)),
+          z(z_), num_weak_learners(num_weak_learners_),
+          binary(binary_), dai_fletcher(dai_fletcher_), x(z_.dim)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        if(dai_fletcher)
+        {
+            DenseVector a(z.dim, binary? 1.0 : 0.0);
+            DenseVector l(z.dim, 0.0);
+            DenseVector u(z.dim, 1.0);
+            if(binary)
+            {
+                a.val[num_weak_learners] = 0.0;
+                l.val[num_weak_learners] = -Optimizer::infinity;
+                u.val[num_weak_learners] = Optimizer::infinity;
+            }
+            else
+            {
+                for(size_t i = 0; i < num_weak_learners; i++)
+                {
+                    a.val[i] = 1.0;
+                }
+                for(size_t i = num_weak_learners; i < z.dim; i++)
+                {
+                    u.val[i] = Optimizer::infinity;
+                }
+            }
+            dai_fletcher_project(x, a, 1.0, z, l, u, DaiAndFletcher::max_iter);
+        }
+        else
+        {
+            copy(z, x);
+            if(binary)
+            {
+                simplex_projection.project(x, num_weak_learners, num_weak_learners + 1, 1.0);
+            }
+            else
+            {
+                simplex_projection.project(x, num_weak_learners, x.dim, 1.0);
+                for(size_t i = num_weak_learners; i < x.dim; i++)
+                {
+                    x.val[i] = std::max(x.val[i], 0.0);
+                }
+            }
+        }
+        sink += x.val[0];
+        return;
+    }
+};
+
+
+/// Capped distribution of margins (the psi minimized out of the ERLPBoost dual)
+class CappedSoftmaxKernel: public Kernel
+{
+    const DenseVector &margins;
+    const double eta, nu;
+    DenseVector distribution;
+    CappedSoftmax capped_softmax;
+public:
+    CappedSoftmaxKernel(const std::string &name_, const DenseVector &margins_, const double eta_, const double nu_)
+        : Kernel(name_, margins_.dim, 2.0*margins_.dim*sizeof(double)),
+          margins(margins_), eta(eta_), nu(nu_), distribution(margins_.dim)
+    {
+        // nothing to do here
+        return;
+    }
+
+    void run()
+    {
+        sink += capped_softmax.evaluate(margins, eta, nu, distribution);
+        return;
+    }
+};
+
+
+// ----------------------------------------------------------------------
+
+class BenchmarkSettings
+{
+public:
+    size_t num_examples, num_features, num_columns;
+    double density;
+    int repetitions;
+    double min_time;
+};
+
+
+void run_benchmark(Kernel &kernel, const BenchmarkSettings &settings, std::ostream &output)
+{
+    // warm up the caches
+    kernel.run();
+
+    std::vector<double> times_ns;
+    size_t kernel_allocations = 0, kernel_allocated_bytes = 0;
+
+    double total_ns = 0;
+    while(int(times_ns.size()) < settings.repetitions or total_ns < settings.min_time*1e9)
+    {
+        // only the kernel allocations are counted, not the growth of times_ns
+        const size_t allocations_before = num_allocations;
+        const size_t allocated_bytes_before = num_allocated_bytes;
+        const uint64_t start_ns = Profiler::now_ns();
+        kernel.run();
+        const uint64_t end_ns = Profiler::now_ns();
+        kernel_allocations += num_allocations - allocations_before;
+        kernel_allocated_bytes += num_allocated_bytes - allocated_bytes_before;
+        times_ns.push_back(end_ns - start_ns);
+        total_ns += end_ns - start_ns;
+    }
+
+    const size_t runs = times_ns.size();
+    const double allocations = double(kernel_allocations)/runs;
+    const double allocated_bytes = double(kernel_allocated_bytes)/runs;
+
+    std::sort(times_ns.begin(), times_ns.end());
+    const double median_ns = times_ns[runs/2];
+    const double best_ns = times_ns[0];
+
+    output << "{\"kernel\": \"" << kernel.name << "\", "
+           << "\"N\": " << settings.num_examples << ", "
+           << "\"D\": " << settings.num_features << ", "
+           << "\"T\": " << settings.num_columns << ", "
+           << "\"density\": " << settings.density << ", "
+           << "\"runs\": " << runs << ", "
+           << "\"median_ns\": " << median_ns << ", "
+           << "\"best_ns\": " << best_ns << ", "
+           << "\"ns_per_element\": " << median_ns/kernel.elements << ", "
+           << "\"gb_per_s\": " << kernel.bytes/median_ns << ", "
+           << "\"allocations_per_run\": " << allocations << ", "
+           << "\"allocated_bytes_per_run\": " << allocated_bytes << "}" << std::endl;
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        std::stringstream os;
+        os <<"You need to run this program as: bench_kernels name_of_config_file"
+          << std::endl
+          << "See bench_kernels.config.ini for an example"
+          << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    ConfigFile config(argv[1]);
+
+    SyntheticDataSettings data_settings;
+    data_settings.num_examples = 100000;
+    data_settings.read(config);
+
+    BenchmarkSettings settings;
+    settings.num_examples = data_settings.num_examples;
+    settings.num_features = data_settings.num_features;
+    settings.density = data_settings.density;
+    config.readInto(settings.num_columns, "T", size_t(50));
+    config.readInto(settings.repetitions, "repetitions", 10);
+    config.readInto(settings.min_time, "min_time", 0.5);
+
+    std::string output_filepath;
+    config.readInto(output_filepath, "output_file", std::string("bench_kernels.jsonl"));
+
+    std::ofstream output(output_filepath.c_str(), std::ios::app);
+    if(not output.good())
+    {
+        std::stringstream os;
+        os <<"Cannot open output file : " << output_filepath << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+    output.precision(6);
+
+    // inputs --
+    std::vector<SparseVector> data;
+    std::vector<int> labels;
+    const SyntheticDataGenerator generator(data_settings);
+    generator.generate_transpose(0, settings.num_examples, data, labels);
+
+    double nnz = 0;
+    for(size_t j = 0; j < data.size(); j++)
+    {
+        nnz += data[j].nnz;
+    }
+
+    const DenseVector uniform_distribution(settings.num_examples, 1.0/settings.num_examples);
+    DenseVector x(settings.num_examples, 0.5), y(settings.num_examples, 0.25);
+
+    std::vector<DenseVector> columns(settings.num_columns, DenseVector(settings.num_examples));
+    for(size_t t = 0; t < columns.size(); t++)
+    {
+        const SparseVector &feature = data[1 + t % (data.size() - 1)];
+        for(size_t k = 0; k < feature.nnz; k++)
+        {
+            columns[t].val[feature.index[k]] = feature.val[k];
+        }
+    }
+    const DenseVector column_weights(settings.num_columns, 1.0/settings.num_columns);
+
+    double init_edge = 0;
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+        init_edge += uniform_distribution.val[i]*labels[i];
+    }
+
+    // a projected gradient step, T weights followed by N psi (or beta and N rho)
+    DenseVector projection_input(settings.num_columns + settings.num_examples);
+    for(size_t i = 0; i < projection_input.dim; i++)
+    {
+        projection_input.val[i] = 0.5*std::sin(double(i));
+    }
+
+    // the oracle and optimizer are chatty, keep their messages out of the way
+    std::streambuf *cout_buffer = std::cout.rdbuf();
+    std::ostringstream silenced_output;
+    std::cout.rdbuf(silenced_output.rdbuf());
+
+    const bool reflexive = true;
+    const DecisionStump stump_oracle(data, labels, reflexive);
+
+    DenseVector distribution(uniform_distribution);
+    const double epsilon = 0.01, nu = 1.0;
+    const double eta = 2.0*std::log(settings.num_examples/nu)/epsilon;
+    LbfgsbOptimizer optimizer(settings.num_examples, true, eta, nu, epsilon, false);
+    optimizer.set_distribution(distribution);
+    for(size_t t = 0; t < settings.num_columns; t++)
+    {
+        optimizer.push_back(data[1 + t % (data.size() - 1)]);
+    }
+
+    // kernels --
+    DenseDotKernel dense_dot(x, y);
+    DenseAxpyKernel dense_axpy(x, y);
+    SparseColumnsDotKernel sparse_columns_dot(data, uniform_distribution, nnz);
+    DenseColumnsDotKernel dense_columns_dot(columns, uniform_distribution);
+    DenseColumnsTransposeDotKernel dense_columns_transpose_dot(columns, column_weights);
+    RelativeEntropyKernel relative_entropy_kernel(uniform_distribution);
+    StumpScanKernel stump_scan(stump_oracle, uniform_distribution, settings.num_features, nnz, init_edge);
+    ErlpFunctionKernel erlp_function(optimizer, settings.num_examples, settings.num_columns);
+    ErlpGradientKernel erlp_gradient(optimizer, settings.num_examples, settings.num_columns);
+    ProjectionKernel erlp_projection_dai_fletcher("erlp_projection_dai_fletcher", projection_input,
+                                                  settings.num_columns, false, true);
+    ProjectionKernel erlp_projection_simplex("erlp_projection_simplex", projection_input,
+                                             settings.num_columns, false, false);
+    ProjectionKernel binary_projection_dai_fletcher("binary_projection_dai_fletcher", projection_input,
+                                                    settings.num_columns, true, true);
+    ProjectionKernel binary_projection_simplex("binary_projection_simplex", projection_input,
+                                               settings.num_columns, true, false);
+
+    // an iterate sitting at a vertex, all the other coordinates tied at 0
+    DenseVector tied_projection_input(settings.num_columns + settings.num_examples, 0.0);
+    tied_projection_input.val[0] = 10.0;
+    ProjectionKernel erlp_projection_simplex_tied("erlp_projection_simplex_tied", tied_projection_input,
+                                                  settings.num_columns, false, false);
+    ProjectionKernel binary_projection_simplex_tied("binary_projection_simplex_tied", tied_projection_input,
+                                                    settings.num_columns, true, false);
+
+    // soft margin, a tenth of the examples at most are capped
+    DenseVector margins(settings.num_examples);
+    for(size_t i = 0; i < margins.dim; i++)
+    {
+        margins.val[i] = 0.5*std::sin(double(i));
+    }
+    const double soft_nu = 0.1*settings.num_examples;
+    CappedSoftmaxKernel capped_softmax("capped_softmax", margins,
+                                       2.0*std::log(settings.num_examples/soft_nu)/epsilon, soft_nu);
+
+    // margins of a single decision stump, all tied at +-1 but for a few
+    // outliers: the ties must be accepted or rejected at once
+    DenseVector tied_margins(settings.num_examples);
+    for(size_t i = 0; i < tied_margins.dim; i++)
+    {
+        tied_margins.val[i] = (i < 10)? -10.0 : ((i % 2 == 0)? 1.0 : -1.0);
+    }
+    CappedSoftmaxKernel capped_softmax_tied("capped_softmax_tied", tied_margins, 1.0,
+                                            std::min(100.0, double(settings.num_examples)));
+
+    Kernel *kernels[] = {&dense_dot, &dense_axpy,
+                         &sparse_columns_dot, &dense_columns_dot, &dense_columns_transpose_dot,
+                         &relative_entropy_kernel, &stump_scan,
+                         &erlp_function, &erlp_gradient,
+                         &erlp_projection_dai_fletcher, &erlp_projection_simplex,
+                         &binary_projection_dai_fletcher, &binary_projection_simplex,
+                         &erlp_projection_simplex_tied, &binary_projection_simplex_tied,
+                         &capped_softmax, &capped_softmax_tied};
+    const size_t num_kernels = sizeof(kernels)/sizeof(kernels[0]);
+
+    std::string selected_kernels;
+    config.readInto(selected_kernels, "kernels", std::string("all"));
+
+    for(size_t k = 0; k < num_kernels; k++)
+    {
+        if(selected_kernels == "all" or selected_kernels.find(kernels[k]->name) != std::string::npos)
+        {
+            run_benchmark(*kernels[k], settings, output);
+        }
+    }
+
+    std::cout.rdbuf(cout_buffer);
+    std::cout << "Results appended to " << output_filepath << " (checksum " << sink << ")" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+
+#include "SyntheticData.hpp"
+#include "BinaryCache.hpp"
+#include "ConfigFile.hpp"
+#include "Timer.hpp"
+
+#include <boost/scoped_ptr.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace totally_corrective_boosting;
+
+
+/// Writes the examples [first_row, first_row + num_rows) of the generator,
+/// one at a time
+void write_dataset(const SyntheticDataGenerator &generator,
+                   const size_t first_row, const size_t num_rows,
+                   const std::string &filepath, const std::string &format)
+{
+    boost::scoped_ptr<BinaryCacheWriter> cache_writer;
+    FILE *libsvm_file = NULL;
+
+    if(format == "cache")
+    {
+        cache_writer.reset(new BinaryCacheWriter(filepath));
+    }
+    else if(format == "libsvm")
+    {
+        libsvm_file = std::fopen(filepath.c_str(), "w");
+        if(libsvm_file == NULL)
+        {
+            std::stringstream os;
+            os <<"Cannot open output file : " << filepath << std::endl;
+            throw std::invalid_argument(os.str());
+        }
+    }
+    else
+    {
+        std::stringstream os;
+        os << "Unknown format " << format << " (libsvm or cache)" << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    int label = 0;
+    std::vector<size_t> indices;
+    std::vector<double> values;
+    size_t nnz = 0;
+    for(size_t i = 0; i < num_rows; i++)
+    {
+        generator.generate_row(first_row + i, label, indices, values);
+        nnz += indices.size();
+
+        if(cache_writer)
+        {
+            cache_writer->write_row(label, indices, values);
+        }
+        else
+        {
+            std::fprintf(libsvm_file, "%+d", label);
+            for(size_t k = 0; k < indices.size(); k++)
+            {
+                std::fprintf(libsvm_file, " %zu:%.8g", indices[k], values[k]);
+            }
+            std::fputc('\n', libsvm_file);
+        }
+
+        if((i + 1) % 1000000 == 0)
+        {
+            std::cout << "    " << i + 1 << " examples" << std::endl;
+        }
+    }
+
+    if(cache_writer)
+    {
+        cache_writer->close();
+    }
+    else
+    {
+        std::fclose(libsvm_file);
+    }
+
+    std::cout << "Wrote " << num_rows << " examples, " << nnz << " non zeros to " << filepath << std::endl;
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        std::stringstream os;
+        os <<"You need to run this program as: generate_dataset name_of_config_file"
+          << std::endl
+          << "See generate_dataset.config.ini for an example"
+          << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    ConfigFile config(argv[1]);
+
+    SyntheticDataSettings settings;
+    settings.read(config);
+
+    std::string train_filepath, test_filepath, format;
+    config.readInto(train_filepath, "train_file");
+    config.readInto(test_filepath, "test_file", std::string());
+    config.readInto(format, "format", std::string("libsvm"));
+
+    size_t num_test_examples = 0;
+    config.readInto(num_test_examples, "test_N", settings.num_examples/4);
+
+    const SyntheticDataGenerator generator(settings);
+
+    Timer timer;
+    timer.start();
+
+    write_dataset(generator, 0, settings.num_examples, train_filepath, format);
+    if(not test_filepath.empty())
+    {
+        // same distribution (and hidden model), different examples
+        write_dataset(generator, settings.num_examples, num_test_examples, test_filepath, format);
+    }
+
+    timer.stop();
+    std::cout << "Generated in " << timer.last_wall_clock << " s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+
+#include "optimizers/AbstractOptimizer.hpp"
+#include "optimizers/optimizers_factory.hpp"
+#include "optimizers/SolverTrace.hpp"
+
+#include "ConfigFile.hpp"
+#include "Timer.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace totally_corrective_boosting;
+
+
+/// Sums over all the solves of a replay
+class ReplaySummary
+{
+public:
+    size_t num_solves;
+    size_t iterations, function_evaluations, gradient_evaluations;
+    double time;
+    size_t gaps_met;
+    double max_dual_objective_difference;
+
+    ReplaySummary()
+        : num_solves(0), iterations(0), function_evaluations(0), gradient_evaluations(0),
+          time(0), gaps_met(0), max_dual_objective_difference(0)
+    {
+        // nothing to do here
+    }
+};
+
+
+/// Feeds the trace to a new optimizer of type optimizer_type
+ReplaySummary replay(const ConfigFile &base_config,
+                     const std::string &trace_filepath,
+                     const std::string &optimizer_type,
+                     const size_t max_solves,
+                     std::ostream &output)
+{
+    ConfigFile config(base_config);
+    config.add("optimizer_type", optimizer_type);
+
+    SolverTraceReader trace(trace_filepath);
+
+    // the optimizer writes into the distribution, it must outlive it
+    DenseVector distribution(trace.distribution);
+
+    std::ofstream null_stream("/dev/null");
+    const bool transposed = true;
+    boost::shared_ptr<AbstractOptimizer>
+            optimizer( new_optimizer_instance(config, trace.dim, transposed,
+                                              trace.eta, trace.nu, trace.epsilon,
+                                              trace.binary, null_stream) );
+    optimizer->set_distribution(distribution);
+
+    ReplaySummary summary;
+    size_t num_columns = 0;
+    SolverTraceEvent event;
+    while(trace.next(event) and (max_solves == 0 or summary.num_solves < max_solves))
+    {
+        if(event.type == SolverTraceEvent::column)
+        {
+            optimizer->push_back(event.column_values);
+            num_columns += 1;
+            continue;
+        }
+
+        const size_t function_evaluations_before = optimizer->get_num_function_evaluations();
+        const size_t gradient_evaluations_before = optimizer->get_num_gradient_evaluations();
+
+        // to the tolerance of the recorded solve (see adaptive_tolerance)
+        optimizer->set_gap_tolerance(event.statistics.gap_tolerance);
+
+        Timer solve_timer;
+        solve_timer.start();
+        const int info = optimizer->solve();
+        solve_timer.stop();
+
+        const size_t iterations = optimizer->get_num_iterations();
+        const size_t function_evaluations = optimizer->get_num_function_evaluations() - function_evaluations_before;
+        const size_t gradient_evaluations = optimizer->get_num_gradient_evaluations() - gradient_evaluations_before;
+
+        // same criterion as AbstractOptimizer::duality_gap_met
+        const double gap = optimizer->min_primal + optimizer->dual_obj;
+        const bool gap_met = (gap < optimizer->get_gap_tolerance());
+
+        const double dual_objective_difference = std::fabs(optimizer->dual_obj - event.statistics.dual_objective);
+
+        output << "{\"optimizer\": \"" << optimizer_type << "\", "
+               << "\"solve\": " << summary.num_solves << ", "
+               << "\"columns\": " << num_columns << ", "
+               << "\"info\": " << info << ", "
+               << "\"iterations\": " << iterations << ", "
+               << "\"function_evaluations\": " << function_evaluations << ", "
+               << "\"gradient_evaluations\": " << gradient_evaluations << ", "
+               << "\"time_to_gap\": " << solve_timer.last_wall_clock << ", "
+               << "\"duality_gap\": " << gap << ", "
+               << "\"gap_tolerance\": " << optimizer->get_gap_tolerance() << ", "
+               << "\"gap_met\": " << (gap_met? "true" : "false") << ", "
+               << "\"dual_objective\": " << optimizer->dual_obj << ", "
+               << "\"recorded_iterations\": " << event.statistics.iterations << ", "
+               << "\"recorded_time\": " << event.statistics.time << ", "
+               << "\"recorded_dual_objective\": " << event.statistics.dual_objective << "}"
+               << std::endl;
+
+        summary.num_solves += 1;
+        summary.iterations += iterations;
+        summary.function_evaluations += function_evaluations;
+        summary.gradient_evaluations += gradient_evaluations;
+        summary.time += solve_timer.last_wall_clock;
+        summary.gaps_met += gap_met? 1 : 0;
+        summary.max_dual_objective_difference = std::max(summary.max_dual_objective_difference,
+                                                         dual_objective_difference);
+    }
+
+    return summary;
+}
+
+
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        std::stringstream os;
+        os <<"You need to run this program as: replay_solver name_of_config_file"
+          << std::endl
+          << "See replay_solver.config.ini for an example"
+          << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    ConfigFile config(argv[1]);
+
+    std::string trace_filepath, output_filepath, optimizers;
+    config.readInto(trace_filepath, "solver_trace_file");
+    config.readInto(output_filepath, "output_file", std::string("replay_solver.jsonl"));
+    config.readInto(optimizers, "optimizers", std::string("lbfgsb pg hz fista fw newton cd"));
+
+    size_t max_solves = 0;
+    config.readInto(max_solves, "max_solves", size_t(0));
+
+    std::ofstream output(output_filepath.c_str());
+    if(not output.good())
+    {
+        std::stringstream os;
+        os <<"Cannot open output file : " << output_filepath << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    {
+        const SolverTraceReader trace(trace_filepath);
+        std::cout << "Trace " << trace_filepath << ": dim " << trace.dim
+                  << ", eta " << trace.eta << ", nu " << trace.nu
+                  << ", epsilon " << trace.epsilon
+                  << ", binary " << (trace.binary? "true" : "false") << std::endl;
+    }
+
+    // the optimizers are chatty
+    std::ofstream silenced_output("/dev/null");
+    std::streambuf *cout_buffer = std::cout.rdbuf();
+
+    std::istringstream optimizers_stream(optimizers);
+    std::string optimizer_type;
+    while(optimizers_stream >> optimizer_type)
+    {
+        std::cout.rdbuf(silenced_output.rdbuf());
+        const ReplaySummary summary = replay(config, trace_filepath, optimizer_type, max_solves, output);
+        std::cout.rdbuf(cout_buffer);
+
+        std::cout << optimizer_type << ": "
+                  << summary.num_solves << " solves, "
+                  << summary.time << " s, "
+                  << summary.iterations << " iterations, "
+                  << summary.function_evaluations << " function and "
+                  << summary.gradient_evaluations << " gradient evaluations, "
+                  << "gap met " << summary.gaps_met << "/" << summary.num_solves << ", "
+                  << "max |dual - recorded dual| " << summary.max_dual_objective_difference
+                  << std::endl;
+    }
+
+    std::cout << "Per solve results written to " << output_filepath << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+
+#include "LibSvmReader.hpp"
+
+#include "oracles/oracles_factory.hpp"
+
+#include "boosters/AbstractBooster.hpp"
+#include "boosters/SuccessiveHalving.hpp"
+
+#include "EvaluateLoss.hpp"
+#include "ConfigFile.hpp"
+#include "MemoryAccounting.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <iostream>
+#include <fstream>
+
+#include <sstream>
+#include <stdexcept>
+
+
+using namespace totally_corrective_boosting;
+
+
+/// The held out files may have less features than the training file
+void backfill(std::vector<SparseVector> &data, const size_t num_features)
+{
+    while(data.size() < num_features)
+    {
+        SparseVector empty(data[0].dim,1);
+        data.push_back(empty);
+    }
+    return;
+}
+
+
+int main(int argc, char **argv)
+{
+
+    if(argc != 2)
+    {
+        std::stringstream os;
+        os <<"You need to run this program as: successive_halving name_of_config_file"
+          << std::endl
+          << "See successive_halving.config.ini for an example"
+          << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    ConfigFile config(argv[1]);
+
+    std::string train_filepath, valid_filepath, test_filepath;
+    config.readInto(train_filepath, "train_file");
+    config.readInto(valid_filepath, "valid_file");
+    config.readInto(test_filepath, "test_file");
+
+    std::string log_filepath;
+    config.readInto(log_filepath, "output_file");
+
+    // the candidate boosters are quite verbose, their output goes to the log file only
+    std::ofstream log_file_stream;
+    log_file_stream.open(log_filepath.c_str());
+    if(not log_file_stream.good())
+    {
+        std::stringstream os;
+        os <<"Cannot open log file : " << log_filepath << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    // read input data --
+    LibSVMReader svm_reader;
+    const bool transposed = true;
+
+    std::vector<SparseVector> data, validation_data;
+    std::vector<int> labels, validation_labels;
+    svm_reader.read_transpose(train_filepath, data, labels);
+    svm_reader.read_transpose(valid_filepath, validation_data, validation_labels);
+    backfill(validation_data, data.size());
+
+    // the estimate is for a single candidate
+    MemoryAccounting::enforce_budget(config, data, labels, std::cout);
+
+    boost::shared_ptr<AbstractOracle> oracle( new_oracle_instance(config, data, labels, transposed, std::cout) );
+
+    SuccessiveHalving scheduler(config, labels, oracle, validation_data, validation_labels, log_file_stream);
+
+    // Key call, this is where all the action is happening
+    ParameterSearchCandidate best = scheduler.search(std::cout);
+
+    std::cout << std::endl << "-----------------------" << std::endl;
+
+    // get test error of the selected configuration --
+    if(not test_filepath.empty())
+    {
+        std::vector<SparseVector> test_data;
+        std::vector<int> test_labels;
+        svm_reader.read_transpose(test_filepath, test_data, test_labels);
+        backfill(test_data, data.size());
+
+        EvaluateLoss score;
+        const DenseVector test_predictions = best.booster->get_ensemble().predict(test_data);
+        int test_loss;
+        double test_err;
+        score.binary_loss(test_predictions, test_labels, test_loss, test_err);
+
+        std::cout << "Selected configuration: " << best.description << std::endl;
+        std::cout << "test error: " << test_err*100 << "% (accuracy " <<  100 - test_err*100 << " %)" << std::endl;
+        std::cout << std::endl << "-----------------------" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
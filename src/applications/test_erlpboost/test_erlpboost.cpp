@@ -1,5 +1,6 @@
 
 #include "LibSvmReader.hpp"
+#include "ExampleDeduplication.hpp"
 
 #include "oracles/oracles_factory.hpp"
 
@@ -9,6 +10,9 @@
 #include "EvaluateLoss.hpp"
 #include "parse.hpp"
 #include "ConfigFile.hpp"
+#include "Profiler.hpp"
+#include "MetricsWriter.hpp"
+#include "MemoryAccounting.hpp"
 
 #include <boost/shared_ptr.hpp>
 
@@ -57,6 +61,16 @@ int main(int argc, char **argv)
     std::string log_filepath;
     config.readInto(log_filepath, "output_file");
 
+    // profiler outputs, only filled when compiled with USE_PROFILER
+    std::string profile_filepath, trace_filepath;
+    config.readInto(profile_filepath, "profile_file", std::string());
+    config.readInto(trace_filepath, "trace_file", std::string());
+
+    if(not trace_filepath.empty())
+    {
+        Profiler::enable_tracing();
+    }
+
 
     std::ofstream log_file_stream;
     log_file_stream.open(log_filepath.c_str());
@@ -82,22 +96,48 @@ int main(int argc, char **argv)
 
     if(transposed)
     {
-        svm_reader.readlibSVM_transpose(train_filepath, data, labels);
+        svm_reader.read_transpose(train_filepath, data, labels);
     }
     else
     {
         svm_reader.readlibSVM(train_filepath, data, labels);
     }
 
+    // identical examples are kept once, with their number of copies
+    bool deduplicate = false;
+    config.readInto(deduplicate, "deduplicate_examples", false);
+    DenseVector multiplicities(labels.size(), 1.0);
+    if(deduplicate)
+    {
+        const size_t num_examples = labels.size();
+        deduplicate_examples(data, labels, transposed, multiplicities);
+        log_stream << "Deduplicated the training examples: " << labels.size()
+                   << " distinct examples out of " << num_examples << std::endl;
+    }
+
+    // refuse to start if the configuration does not fit in memory_budget_mb
+    MemoryAccounting::enforce_budget(config, data, labels, log_stream);
+
     // create oracle and booster
     boost::shared_ptr<AbstractOracle> oracle( new_oracle_instance(config, data, labels, transposed, log_stream) );
-    boost::shared_ptr<AbstractBooster> ensemble_booster( new_booster_instance(config, labels, oracle, log_stream) );
+    boost::shared_ptr<AbstractBooster> ensemble_booster( new_booster_instance(config, labels, multiplicities, oracle, log_stream) );
 
     if(not ensemble_booster)
     {
         throw std::runtime_error("Failed to create an ensemble booster. Check your configuration file.");
     }
 
+    // one structured record per iteration
+    std::string metrics_filepath, metrics_format;
+    config.readInto(metrics_filepath, "metrics_file", std::string());
+    config.readInto(metrics_format, "metrics_format", std::string("jsonl"));
+
+    if(not metrics_filepath.empty())
+    {
+        boost::shared_ptr<MetricsWriter> metrics_writer(new MetricsWriter(metrics_filepath, metrics_format));
+        ensemble_booster->set_metrics_writer(metrics_writer);
+    }
+
     // Key call, this is where all the action is happening
     const size_t num_models = ensemble_booster->boost(log_stream);
 
@@ -113,7 +153,7 @@ int main(int argc, char **argv)
         DenseVector train_predictions = model.predict(data);
         int train_loss;
         double train_err;
-        score.binary_loss(train_predictions, labels, train_loss, train_err);
+        score.binary_loss(train_predictions, labels, multiplicities, train_loss, train_err);
 
         log_stream << "Evaluated " << train_predictions.dim << " predictions" << std::endl;
         log_stream << "training error: " << train_err*100 << "% (accuracy " <<  100 - train_err*100 << " %)" << std::endl;
@@ -124,7 +164,7 @@ int main(int argc, char **argv)
     std::vector<SparseVector> test_data;
     std::vector<int> test_labels;
     {
-        svm_reader.readlibSVM_transpose(test_filepath, test_data, test_labels);
+        svm_reader.read_transpose(test_filepath, test_data, test_labels);
         // backfill
         while(test_data.size() < data.size())
         {
@@ -147,7 +187,7 @@ int main(int argc, char **argv)
     {
         if(valid_filepath != "no_valid")
         {
-            svm_reader.readlibSVM_transpose(valid_filepath, validation_data, valid_labels);
+            svm_reader.read_transpose(valid_filepath, validation_data, valid_labels);
 
             // backfill
             while(validation_data.size() < data.size())
@@ -229,6 +269,20 @@ int main(int argc, char **argv)
 
     }
 
+    MemoryAccounting::report(log_stream);
+
+    if(not profile_filepath.empty())
+    {
+        Profiler::write_json(profile_filepath);
+        log_stream << "Profile written to " << profile_filepath << std::endl;
+    }
+
+    if(not trace_filepath.empty())
+    {
+        Profiler::write_chrome_trace(trace_filepath);
+        log_stream << "Trace written to " << trace_filepath << std::endl;
+    }
+
     log_stream.close();
 
     // Reseting the smart pointer will push for memory de-allocation
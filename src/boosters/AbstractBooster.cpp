@@ -1,8 +1,13 @@
 
 #include "AbstractBooster.hpp"
 
+#include "Profiler.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
+#include "MemoryUsage.hpp"
+
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
 
 namespace totally_corrective_boosting
 {
@@ -12,7 +17,9 @@ AbstractBooster::AbstractBooster(const boost::shared_ptr<AbstractOracle> &oracle
                                  const int num_data_points_,
                                  const int max_iterations_)
     : oracle(oracle_), num_data_points(num_data_points_),
-      max_iterations(max_iterations_), display_frequency(10)
+      max_iterations(max_iterations_), display_frequency(10),
+      example_multiplicities(num_data_points_, 1.0), weighted_examples(false),
+      iteration(0), converged(false), weak_learners_per_iteration(1)
 {
 
     assert(oracle);
@@ -34,7 +41,9 @@ AbstractBooster::AbstractBooster(const boost::shared_ptr<AbstractOracle> &oracle
                                  const int max_iterations_,
                                  const int display_frequency_)
     : oracle(oracle_), num_data_points(num_data_points_),
-      max_iterations(max_iterations_), display_frequency(display_frequency_)
+      max_iterations(max_iterations_), display_frequency(display_frequency_),
+      example_multiplicities(num_data_points_, 1.0), weighted_examples(false),
+      iteration(0), converged(false), weak_learners_per_iteration(1)
 {
 
     assert(oracle);
@@ -59,6 +68,187 @@ AbstractBooster::~AbstractBooster()
 }
 
 
+bool AbstractBooster::boost_one_iteration(std::ostream& log_stream)
+{
+    timer.start();
+    oracle_timer.start();
+    AbstractWeakLearner* new_weak_learner = NULL;
+    std::vector<AbstractWeakLearner*> new_weak_learners;
+    {
+        PROFILE_SCOPE(Profiler::oracle_scan);
+        // the oracle may be shared with other boosters, allocate in our model pool
+        oracle->set_weak_learner_pool(model.get_weak_learner_pool());
+        if(weak_learners_per_iteration > 1)
+        {
+            // by decreasing edge, the first one has the max edge
+            new_weak_learners = oracle->find_top_k_weak_learners(examples_distribution,
+                                                                 weak_learners_per_iteration);
+            new_weak_learner = new_weak_learners.front();
+        }
+        else
+        {
+            new_weak_learner = oracle->find_maximum_edge_weak_learner(examples_distribution);
+        }
+    }
+    oracle_timer.stop();
+    update_stopping_criterion(*new_weak_learner);
+    if(stopping_criterion(log_stream))
+    {
+        converged = true;
+        write_iteration_record(*new_weak_learner, oracle_timer.last_wall_clock, 0.0);
+        release_rejected_weak_learners(new_weak_learner, new_weak_learners);
+        return true;
+    }
+    if(new_weak_learners.size() > 1)
+    {
+        solver_timer.start();
+        {
+            PROFILE_SCOPE(Profiler::distribution_update);
+            add_weak_learners(new_weak_learners);
+        }
+        solver_timer.stop();
+    }
+    else
+    {
+        {
+            PROFILE_SCOPE(Profiler::ensemble_update);
+            update_linear_ensemble(*new_weak_learner);
+        }
+        solver_timer.start();
+        {
+            PROFILE_SCOPE(Profiler::distribution_update);
+            update_examples_distribution(*new_weak_learner);
+        }
+        solver_timer.stop();
+    }
+    timer.stop();
+
+    write_iteration_record(*new_weak_learner, oracle_timer.last_wall_clock, solver_timer.last_wall_clock);
+    release_rejected_weak_learners(new_weak_learner, new_weak_learners);
+
+    iteration += 1;
+    return false;
+}
+
+
+void AbstractBooster::release_rejected_weak_learners(const AbstractWeakLearner* new_weak_learner,
+                                                     const std::vector<AbstractWeakLearner*>& new_weak_learners)
+{
+    WeakLearnerPool &pool = *model.get_weak_learner_pool();
+    if(new_weak_learners.empty())
+    {
+        if(not model.holds(new_weak_learner))
+        {
+            pool.destroy(new_weak_learner);
+        }
+        return;
+    }
+    for(size_t i = 0; i < new_weak_learners.size(); i++)
+    {
+        if(not model.holds(new_weak_learners[i]))
+        {
+            pool.destroy(new_weak_learners[i]);
+        }
+    }
+    return;
+}
+
+
+void AbstractBooster::add_weak_learners(const std::vector<AbstractWeakLearner*>& wls)
+{
+    for(size_t i = 0; i < wls.size(); i++)
+    {
+        update_linear_ensemble(*wls[i]);
+        update_examples_distribution(*wls[i]);
+    }
+    return;
+}
+
+
+void AbstractBooster::fill_iteration_record(IterationRecord& /*record*/) const
+{
+    // nothing to do here
+    return;
+}
+
+
+void AbstractBooster::write_iteration_record(const AbstractWeakLearner& wl,
+                                             const double oracle_time,
+                                             const double solver_time)
+{
+    if(not metrics_writer)
+    {
+        return;
+    }
+
+    IterationRecord record;
+    record.iteration = iteration;
+    record.converged = converged;
+    record.feature_index = wl.get_index();
+    record.threshold = wl.get_threshold();
+    record.direction = wl.get_direction();
+    record.edge = wl.get_edge();
+    record.oracle_time = oracle_time;
+    record.solver_time = solver_time;
+    record.iteration_time = converged? oracle_time : timer.last_wall_clock;
+    record.ensemble_size = model.size();
+    record.resident_memory = resident_memory_bytes();
+    record.peak_resident_memory = peak_resident_memory_bytes();
+    for(int t = 0; t < MemoryAccounting::num_tags; t++)
+    {
+        const MemoryAccounting::Tag tag = static_cast<MemoryAccounting::Tag>(t);
+        record.tagged_memory[t] = MemoryAccounting::current_bytes(tag);
+        record.peak_tagged_memory[t] = MemoryAccounting::peak_bytes(tag);
+    }
+
+    fill_iteration_record(record);
+
+    metrics_writer->write(record);
+    return;
+}
+
+
+void AbstractBooster::set_weak_learners_per_iteration(const size_t k)
+{
+    if(k == 0)
+    {
+        throw std::invalid_argument("weak_learners_per_iteration must be at least 1");
+    }
+    weak_learners_per_iteration = k;
+    return;
+}
+
+
+void AbstractBooster::set_example_multiplicities(const DenseVector& multiplicities)
+{
+    if(multiplicities.dim != examples_distribution.dim)
+    {
+        throw std::invalid_argument("set_example_multiplicities needs one multiplicity per example");
+    }
+    if(iteration > 0)
+    {
+        throw std::runtime_error("set_example_multiplicities must be called before boosting");
+    }
+    example_multiplicities = multiplicities;
+    weighted_examples = true;
+
+    // in place, the solvers keep a reference to the distribution
+    const double num_examples = sum(multiplicities);
+    for(size_t i = 0; i < examples_distribution.dim; i++)
+    {
+        examples_distribution.val[i] = multiplicities.val[i]/num_examples;
+    }
+    return;
+}
+
+
+void AbstractBooster::set_metrics_writer(const boost::shared_ptr<MetricsSink> &metrics_writer_)
+{
+    metrics_writer = metrics_writer_;
+    return;
+}
+
+
 size_t AbstractBooster::boost(std::ostream& log_stream)
 {
 
@@ -69,16 +259,10 @@ size_t AbstractBooster::boost(std::ostream& log_stream)
     size_t num_models = 0;
     for(i = 0; i < max_iterations; i++)
     {
-        timer.start();
-        AbstractWeakLearner* new_weak_learner = oracle->find_maximum_edge_weak_learner(examples_distribution);
-        update_stopping_criterion(*new_weak_learner);
-        if(stopping_criterion(log_stream))
+        if(boost_one_iteration(log_stream))
         {
             break;
         }
-        update_linear_ensemble(*new_weak_learner);
-        update_examples_distribution(*new_weak_learner);
-        timer.stop();
 
         if(((i+1)%display_frequency)==0)
         {
@@ -144,6 +328,29 @@ size_t AbstractBooster::boost(std::ostream& log_stream)
 }
 
 
+bool AbstractBooster::boost_iterations(const int num_iterations, std::ostream& log_stream)
+{
+    for(int i = 0; i < num_iterations and not is_finished(); i++)
+    {
+        boost_one_iteration(log_stream);
+    }
+
+    return converged;
+}
+
+
+int AbstractBooster::get_num_iterations() const
+{
+    return iteration;
+}
+
+
+bool AbstractBooster::is_finished() const
+{
+    return converged or (iteration >= max_iterations);
+}
+
+
 const Ensemble &AbstractBooster::get_ensemble() const
 {
     return model;
@@ -4,6 +4,7 @@
 #include "Ensemble.hpp"
 #include "oracles/AbstractOracle.hpp"
 #include "Timer.hpp"
+#include "MetricsWriter.hpp"
 
 #include <boost/shared_ptr.hpp>
 
@@ -39,9 +40,32 @@ protected:
   /// Distribution on the examples
   DenseVector examples_distribution;
 
+  /// Number of identical examples each example stands for (see
+  /// deduplicate_examples), 1 unless set_example_multiplicities was called
+  DenseVector example_multiplicities;
+
+  /// true once set_example_multiplicities was called, the stopping
+  /// criteria then use the weighted entropies
+  bool weighted_examples;
+
   /// Keep track of time per iteration
   Timer timer;
 
+  /// Time spent in the oracle and in the examples distribution update
+  Timer oracle_timer, solver_timer;
+
+  /// Receives one record per iteration, if set
+  boost::shared_ptr<MetricsSink> metrics_writer;
+
+  /// Number of boosting iterations run so far
+  int iteration;
+
+  /// Did the stopping criterion fire ?
+  bool converged;
+
+  /// Weak learners asked to the oracle per iteration (top-k), 1 by default
+  size_t weak_learners_per_iteration;
+
     
   /// Update the strong classifier
   /// (add the new weak learner and update the weights of the weak classifiers)
@@ -52,10 +76,32 @@ protected:
 
   virtual void update_stopping_criterion(const AbstractWeakLearner& wl)=0;
 
+  /// Add several weak learners (from the same distribution) to the model
+  /// and update the distribution. The default adds them one at a time;
+  /// totally corrective boosters push all of them before a single solve
+  virtual void add_weak_learners(const std::vector<AbstractWeakLearner*>& wls);
+
   /// should we stop now ?
   virtual bool stopping_criterion(std::ostream& os)=0;
-  
-  
+
+  /// Run a single boosting iteration
+  /// @returns true if the stopping criterion was met (the model is not updated in that case)
+  bool boost_one_iteration(std::ostream& log_stream);
+
+  /// Derived classes fill in the quantities they know about
+  /// (bounds, gap, inner solver effort), the default does nothing
+  virtual void fill_iteration_record(IterationRecord& record) const;
+
+  void write_iteration_record(const AbstractWeakLearner& wl,
+                              const double oracle_time,
+                              const double solver_time);
+
+  /// Give back to the model pool the new weak learners the model did not
+  /// keep (duplicates merged into an existing one, or never added)
+  void release_rejected_weak_learners(const AbstractWeakLearner* new_weak_learner,
+                                      const std::vector<AbstractWeakLearner*>& new_weak_learners);
+
+
 public:
     
   AbstractBooster(const boost::shared_ptr<AbstractOracle> &oracle_,
@@ -74,9 +120,33 @@ public:
   /// This is the main loop of the training,
   /// this function may take some time to finish...
   size_t boost(std::ostream& log_stream = std::cout);
+
+  /// Continue boosting for (at most) num_iterations more iterations,
+  /// starting from the current in-memory state.
+  /// Used by the parameter search schedulers to resume survivors.
+  /// @returns true if the stopping criterion was met
+  bool boost_iterations(const int num_iterations, std::ostream& log_stream = std::cout);
+
+  /// Number of boosting iterations run so far
+  int get_num_iterations() const;
+
+  /// true if the stopping criterion was met or max_iterations was reached
+  bool is_finished() const;
   
   const Ensemble &get_ensemble() const;
 
+  /// Ask the oracle for the k best weak learners (distinct features) at
+  /// each iteration, instead of one
+  void set_weak_learners_per_iteration(const size_t k);
+
+  /// Example i stands for multiplicities[i] identical examples: the
+  /// distribution starts at multiplicities/sum(multiplicities) and its
+  /// entry i is the mass of all the copies. Must be called before boosting
+  virtual void set_example_multiplicities(const DenseVector& multiplicities);
+
+  /// Emit one IterationRecord per boosting iteration to metrics_writer
+  void set_metrics_writer(const boost::shared_ptr<MetricsSink> &metrics_writer);
+
 
   /// Helper function for debugging and external usage
   const DenseVector&  get_examples_distribution() const;
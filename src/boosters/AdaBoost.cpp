@@ -1,5 +1,6 @@
 
 #include "AdaBoost.hpp"
+#include "math/vector_operations.hpp"
 
 #include <iostream>
 #include <cmath>
@@ -47,7 +48,10 @@ void AdaBoost::update_examples_distribution(const AbstractWeakLearner& weak_lear
 void AdaBoost::update_linear_ensemble(const AbstractWeakLearner &wl)
 {
 
-    double gamma = wl.get_edge();
+    // The edge of wl on the current distribution: when several weak
+    // learners are added per iteration, get_edge() is the edge on the
+    // distribution before the first of them was added
+    const double gamma = dot(wl.get_prediction(), examples_distribution);
     double eps = 0.5*(1.0 - gamma);
     alpha = 0.5*log((1-eps-1e-4)/(eps+1e-4));
     WeightedWeakLearner wwl(&wl, alpha);
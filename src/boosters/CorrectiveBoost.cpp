@@ -1,6 +1,8 @@
 
 #include "CorrectiveBoost.hpp"
 
+#include "Profiler.hpp"
+
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -53,22 +55,20 @@ CorrectiveBoost::~CorrectiveBoost()
     return;
 }
 
-void CorrectiveBoost::update_examples_distribution(const AbstractWeakLearner &wl){
+void CorrectiveBoost::set_example_multiplicities(const DenseVector& multiplicities)
+{
+    AbstractBooster::set_example_multiplicities(multiplicities);
+    capped_softmax.set_multiplicities(multiplicities);
+    return;
+}
 
-    double exp_max = 0.0;
 
-    for(size_t i = 0; i < examples_distribution.dim; i++){
-        examples_distribution.val[i] = -eta * UW.val[i];
-        exp_max = std::max(exp_max,examples_distribution.val[i]);
-    }
+void CorrectiveBoost::update_examples_distribution(const AbstractWeakLearner &wl){
 
-    double dual_obj = 0.0;
-    for(size_t i = 0; i < examples_distribution.dim; i++){
-        examples_distribution.val[i] = exp(examples_distribution.val[i] - exp_max)/examples_distribution.dim;
-        dual_obj += examples_distribution.val[i];
-    }
+    PROFILE_SCOPE(Profiler::projection);
 
-    minPt1dt1 = proj_simplex(examples_distribution, exp_max);
+    // the capped softmax minimizes the negated dual objective
+    minPt1dt1 = -capped_softmax.evaluate(UW, eta, nu, examples_distribution);
 
     return;
 }
@@ -152,65 +152,21 @@ bool CorrectiveBoost::stopping_criterion(std::ostream& log_stream)
 }
 
 
-void CorrectiveBoost::update_stopping_criterion(const AbstractWeakLearner &wl)
+void CorrectiveBoost::fill_iteration_record(IterationRecord& record) const
 {
-    minPqdq1 = std::min(wl.get_edge()+(relative_entropy(examples_distribution)/eta), minPqdq1);
+    record.primal_bound = minPqdq1;
+    record.dual_bound = minPt1dt1;
+    record.gap = minPqdq1 - minPt1dt1;
     return;
 }
 
 
-/// @returns the dual objective function after projection
-double CorrectiveBoost::proj_simplex(DenseVector& dist, const double& exp_max)
+void CorrectiveBoost::update_stopping_criterion(const AbstractWeakLearner &wl)
 {
-
-    double cap = 1.0/nu;
-    double theta = 0.0;
-    size_t dim = dist.dim;
-    int N = dist.dim - 1;
-    DenseVector tmpdist(dist);
-    // sort dist from smallest to largest
-    std::sort(tmpdist.val, tmpdist.val+tmpdist.dim);
-    // store the sum of the dist in Z
-    double Z = sum(tmpdist);
-    // find theta
-    for(size_t i = 0; i < tmpdist.dim; i++)
-    {
-        theta = (1.0 - cap * i)/Z;
-        if(theta * tmpdist.val[N-i] <= cap)
-        {
-            break;
-        }
-        else
-        {
-            Z -= tmpdist.val[N-i];
-        }
-    }
-
-    double ubndsum = 0.0;
-    double psisum = 0.0;
-    size_t bnd = 0;
-
-    for(size_t i = 0; i < dist.dim; i++)
-    {
-        if(theta*dist.val[i] > cap)
-        {
-            bnd++;
-            psisum -= log(dist.val[i]*dim)/eta;
-            dist.val[i] = cap;
-        }
-        else
-        {
-            ubndsum += dist.val[i];
-            dist.val[i] = theta*dist.val[i];
-        }
-    }
-
-    double obj = exp_max + log(ubndsum/(1.0 - cap*bnd));
-    obj *= ((bnd*cap - 1.0)/eta);
-    obj -= ((bnd*cap/eta)*log(nu/dim));
-    obj += psisum;
-
-    return obj;
+    const double entropy = weighted_examples? relative_entropy(examples_distribution, example_multiplicities)
+                                            : relative_entropy(examples_distribution);
+    minPqdq1 = std::min(wl.get_edge()+(entropy/eta), minPqdq1);
+    return;
 }
 
 } // end of namespace totally_corrective_boosting
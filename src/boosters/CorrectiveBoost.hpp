@@ -2,6 +2,7 @@
 #define _CORRECTIVE_HPP_
 
 #include "AbstractBooster.hpp"
+#include "math/capped_softmax.hpp"
 
 namespace totally_corrective_boosting
 {
@@ -33,6 +34,9 @@ private:
     // holds current value of U*w
     DenseVector UW;
 
+    // the distribution of UW, capped at 1/nu
+    CappedSoftmax capped_softmax;
+
 
 protected:
 
@@ -44,8 +48,7 @@ protected:
 
     void update_stopping_criterion(const AbstractWeakLearner& wl);
 
-    /// @returns the dual objective function after projection
-    double proj_simplex(DenseVector& examples_distribution, const double& exp_max);
+    void fill_iteration_record(IterationRecord& record) const;
 
     double line_search(DenseVector ut);
 
@@ -72,6 +75,9 @@ public:
 
     ~CorrectiveBoost();
 
+    /// Also given to the capped softmax
+    void set_example_multiplicities(const DenseVector& multiplicities);
+
 };
 
 } // end of namespace totally_corrective_boosting
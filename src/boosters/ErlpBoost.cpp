@@ -1,11 +1,14 @@
 
 #include "ErlpBoost.hpp"
 #include "math/vector_operations.hpp"
+#include "Timer.hpp"
 
 
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
+#include <sstream>
+#include <algorithm>
 
 
 namespace totally_corrective_boosting
@@ -20,9 +23,13 @@ ErlpBoost::ErlpBoost(const boost::shared_ptr<AbstractOracle> &oracle,
                      const boost::shared_ptr<AbstractOptimizer> &solver_)
     : AbstractBooster(oracle, num_data_points, max_iterations),
       new_weak_learner_was_already_in_model(false),
+      new_weak_learner_index(0),
       binary(binary_),
       minPt1dt1(-1.0), minPqdq1(1.0),
-      epsilon(epsilon_), nu(nu_), solver(solver_)
+      epsilon(epsilon_), nu(nu_), solver(solver_),
+      last_solve_iterations(0), last_solve_function_evaluations(0),
+      last_solve_gradient_evaluations(0),
+      adaptive_tolerance_factor(0), last_solve_tolerance(0.5*epsilon)
 {
 
     if(binary)
@@ -51,8 +58,12 @@ ErlpBoost::ErlpBoost(const boost::shared_ptr<AbstractOracle> &oracle,
                      const boost::shared_ptr<AbstractOptimizer> &solver_)
     : AbstractBooster(oracle, num_data_points, max_iterations),
       new_weak_learner_was_already_in_model(false),
+      new_weak_learner_index(0),
       binary(binary_), minPt1dt1(-1.0), minPqdq1(1.0), epsilon(eps_),
-      nu(nu_), eta(eta_), solver(solver_)
+      nu(nu_), eta(eta_), solver(solver_),
+      last_solve_iterations(0), last_solve_function_evaluations(0),
+      last_solve_gradient_evaluations(0),
+      adaptive_tolerance_factor(0), last_solve_tolerance(0.5*epsilon)
 {
     assert(solver);
     // Set reference to the dist array in the solver
@@ -68,10 +79,40 @@ ErlpBoost::~ErlpBoost()
 }
 
 
+void ErlpBoost::set_example_multiplicities(const DenseVector& multiplicities)
+{
+    AbstractBooster::set_example_multiplicities(multiplicities);
+    solver->set_example_multiplicities(multiplicities);
+    return;
+}
+
+
+void ErlpBoost::record_solver_trace(const std::string &filename)
+{
+    solver_trace.reset(new SolverTraceWriter(filename, examples_distribution.dim,
+                                             eta, nu, epsilon, binary,
+                                             examples_distribution));
+    return;
+}
+
+
+void ErlpBoost::set_adaptive_tolerance(const double factor)
+{
+    if(factor < 0 or factor >= 1)
+    {
+        std::stringstream os;
+        os << "adaptive_tolerance_factor must be in [0, 1), got " << factor;
+        throw std::invalid_argument(os.str());
+    }
+    adaptive_tolerance_factor = factor;
+    return;
+}
+
+
 void ErlpBoost::update_linear_ensemble(const AbstractWeakLearner& weak_learner)
 {
     WeightedWeakLearner weighted_weak_learner(&weak_learner, 0.0);
-    new_weak_learner_was_already_in_model = model.add(weighted_weak_learner);
+    new_weak_learner_was_already_in_model = model.add(weighted_weak_learner, new_weak_learner_index);
     return;
 }
 
@@ -86,17 +127,39 @@ bool ErlpBoost::stopping_criterion(std::ostream& log_stream)
 }
 
 
+void ErlpBoost::fill_iteration_record(IterationRecord& record) const
+{
+    record.primal_bound = minPqdq1;
+    record.dual_bound = minPt1dt1;
+    record.gap = minPqdq1 - minPt1dt1;
+
+    if(not record.converged)
+    {
+        record.solver_iterations = last_solve_iterations;
+        record.function_evaluations = last_solve_function_evaluations;
+        record.gradient_evaluations = last_solve_gradient_evaluations;
+        record.solver_tolerance = last_solve_tolerance;
+    }
+    return;
+}
+
+
 void ErlpBoost::update_stopping_criterion(const AbstractWeakLearner& wl)
 {
 
     double gamma = wl.get_edge();
-    if(binary)
+    if(not weighted_examples)
+    {
+        gamma += ((binary? binary_relative_entropy(examples_distribution, nu)
+                         : relative_entropy(examples_distribution))/eta);
+    }
+    else if(binary)
     {
-        gamma += (binary_relative_entropy(examples_distribution, nu)/eta);
+        gamma += (binary_relative_entropy(examples_distribution, example_multiplicities, nu)/eta);
     }
     else
     {
-        gamma += (relative_entropy(examples_distribution)/eta);
+        gamma += (relative_entropy(examples_distribution, example_multiplicities)/eta);
     }
 
     if(gamma < minPqdq1)
@@ -108,6 +171,26 @@ void ErlpBoost::update_stopping_criterion(const AbstractWeakLearner& wl)
 
 
 void ErlpBoost::update_examples_distribution(const AbstractWeakLearner& weak_learner)
+{
+    push_weak_learner(weak_learner);
+    solve_examples_distribution();
+    return;
+}
+
+
+void ErlpBoost::add_weak_learners(const std::vector<AbstractWeakLearner*>& wls)
+{
+    for(size_t i = 0; i < wls.size(); i++)
+    {
+        update_linear_ensemble(*wls[i]);
+        push_weak_learner(*wls[i]);
+    }
+    solve_examples_distribution();
+    return;
+}
+
+
+void ErlpBoost::push_weak_learner(const AbstractWeakLearner& weak_learner)
 {
 
     // The predictions are already pre-multiplied with the labels already
@@ -118,23 +201,82 @@ void ErlpBoost::update_examples_distribution(const AbstractWeakLearner& weak_lea
         // need to push into the solver
         const SparseVector &prediction = weak_learner.get_prediction();
         solver->push_back(prediction);
+
+        if(solver_trace)
+        {
+            solver_trace->push_back(prediction);
+        }
+    }
+    else
+    {
+        // it may have been retired from the working set of the solver
+        solver->restore_column(new_weak_learner_index);
+    }
+    return;
+}
+
+
+void ErlpBoost::solve_examples_distribution()
+{
+
+    const size_t function_evaluations_before = solver->get_num_function_evaluations();
+    const size_t gradient_evaluations_before = solver->get_num_gradient_evaluations();
+
+    if(adaptive_tolerance_factor > 0)
+    {
+        // The factor is below one, so the tolerance shrinks with the outer gap
+        // until it reaches the exact 0.5*epsilon
+        solver->set_gap_tolerance(adaptive_tolerance_factor*(minPqdq1 - minPt1dt1));
     }
+    last_solve_tolerance = solver->get_gap_tolerance();
 
     // Call the solver
-    const int info = solver->solve();
-    if(info != 0)
+    // Solved again when retired weak learners come back
+    Timer solve_timer;
+    solve_timer.start();
+    do
     {
-        throw std::runtime_error("Something went wrong inside the solver... sorry.");
+        const int info = solver->solve();
+        if(info != 0)
+        {
+            throw std::runtime_error("Something went wrong inside the solver... sorry.");
+        }
+    } while(solver->update_working_set());
+    solve_timer.stop();
+
+    last_solve_iterations = solver->get_num_iterations();
+    last_solve_function_evaluations = solver->get_num_function_evaluations() - function_evaluations_before;
+    last_solve_gradient_evaluations = solver->get_num_gradient_evaluations() - gradient_evaluations_before;
+
+    if(solver_trace)
+    {
+        SolveStatistics statistics;
+        statistics.iterations = last_solve_iterations;
+        statistics.function_evaluations = last_solve_function_evaluations;
+        statistics.gradient_evaluations = last_solve_gradient_evaluations;
+        statistics.time = solve_timer.last_wall_clock;
+        statistics.dual_objective = solver->dual_obj;
+        statistics.min_primal = solver->min_primal;
+        statistics.gap_tolerance = last_solve_tolerance;
+        solver_trace->solve(statistics);
     }
 
     // We get back the distribution and max edge for free.
-    // Only need to read wts back
-    // BEWARE:
-    // Only the relevant entries of solver->x are copied over.
+    // Only need to read wts back, in the order of the model
 
-    model.set_weights(solver->x);
+    model.set_weights(solver->get_weights());
 
-    minPt1dt1 = -solver->dual_obj;
+    if(adaptive_tolerance_factor > 0)
+    {
+        // -dual_obj is a lower bound of P^{t-1}(d^{t-1}) (weak duality) however
+        // loose the solve, and P^{t-1}(d^{t-1}) does not decrease with t:
+        // keep the best bound so that inexact solves never loosen it
+        minPt1dt1 = std::max(minPt1dt1, -solver->dual_obj);
+    }
+    else
+    {
+        minPt1dt1 = -solver->dual_obj;
+    }
     return;
 }
 
@@ -4,6 +4,7 @@
 #include "AbstractBooster.hpp"
 #include "weak_learners/AbstractWeakLearner.hpp"
 #include "optimizers/AbstractOptimizer.hpp"
+#include "optimizers/SolverTrace.hpp"
 
 #include <boost/shared_ptr.hpp>
 
@@ -19,6 +20,10 @@ protected:
 
     bool new_weak_learner_was_already_in_model;
 
+    /// Position of the new weak learner in the model (and in the push
+    /// order of the solver)
+    size_t new_weak_learner_index;
+
     /// Are we going to use Binary relative entropy
     bool binary;
 
@@ -42,16 +47,40 @@ protected:
     /// solver
     boost::shared_ptr<AbstractOptimizer> solver;
 
+    /// Effort of the solver during the last call to update_examples_distribution
+    size_t last_solve_iterations, last_solve_function_evaluations, last_solve_gradient_evaluations;
+
+    /// Inner solves stop at a duality gap of adaptive_tolerance_factor times
+    /// the outer gap (0 means always at 0.5*epsilon)
+    double adaptive_tolerance_factor;
+
+    /// Duality gap tolerance of the last solve
+    double last_solve_tolerance;
+
+    /// Records the columns and calls to solve(), if set
+    boost::shared_ptr<SolverTraceWriter> solver_trace;
+
 protected:
 
     void update_examples_distribution(const AbstractWeakLearner& wl);
 
     void update_linear_ensemble(const AbstractWeakLearner& wl);
 
+    /// All the columns are pushed before a single solve
+    void add_weak_learners(const std::vector<AbstractWeakLearner*>& wls);
+
+    /// Give the column of the weak learner just added to the model to the solver
+    void push_weak_learner(const AbstractWeakLearner& wl);
+
+    /// Solve, then read back the weights of the model (and the lower bound)
+    void solve_examples_distribution();
+
     bool stopping_criterion(std::ostream& log_stream);
 
     void update_stopping_criterion(const AbstractWeakLearner& wl);
 
+    void fill_iteration_record(IterationRecord& record) const;
+
 public:
 
     ErlpBoost(const boost::shared_ptr<AbstractOracle> &oracle,
@@ -73,6 +102,17 @@ public:
 
     virtual ~ErlpBoost();
 
+    /// Also given to the solver
+    void set_example_multiplicities(const DenseVector& multiplicities);
+
+    /// Write the problems given to the solver to a trace file (see replay_solver),
+    /// must be called before boosting
+    void record_solver_trace(const std::string &filename);
+
+    /// Solve loosely while the outer gap is large: the inner tolerance is
+    /// max(0.5*epsilon, factor*(minPqdq1 - minPt1dt1)), with 0 <= factor < 1
+    void set_adaptive_tolerance(const double factor);
+
 };
 
 } // end of namespace totally_corrective_boosting
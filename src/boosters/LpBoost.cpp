@@ -58,6 +58,17 @@ LpBoost::~LpBoost()
 }
 
 
+void LpBoost::set_example_multiplicities(const DenseVector& multiplicities)
+{
+    AbstractBooster::set_example_multiplicities(multiplicities);
+    for(size_t i = 0; i < multiplicities.dim; i++)
+    {
+        solver.setColumnBounds(i+1, 0.0, multiplicities.val[i]/nu);
+    }
+    return;
+}
+
+
 void LpBoost::update_linear_ensemble(const AbstractWeakLearner &wl)
 {
     WeightedWeakLearner wwl(&wl, 1.0);
@@ -73,6 +84,15 @@ bool LpBoost::stopping_criterion(std::ostream& os)
 }
 
 
+void LpBoost::fill_iteration_record(IterationRecord& record) const
+{
+    record.primal_bound = minPqdq1;
+    record.dual_bound = minPt1dt1;
+    record.gap = minPqdq1 - minPt1dt1;
+    return;
+}
+
+
 void LpBoost::update_stopping_criterion(const AbstractWeakLearner &wl)
 {
     const double gamma = wl.get_edge();
@@ -85,6 +105,26 @@ void LpBoost::update_stopping_criterion(const AbstractWeakLearner &wl)
 
 
 void LpBoost::update_examples_distribution(const AbstractWeakLearner &wl)
+{
+    add_row(wl);
+    solve_examples_distribution();
+    return;
+}
+
+
+void LpBoost::add_weak_learners(const std::vector<AbstractWeakLearner*>& wls)
+{
+    for(size_t i = 0; i < wls.size(); i++)
+    {
+        update_linear_ensemble(*wls[i]);
+        add_row(*wls[i]);
+    }
+    solve_examples_distribution();
+    return;
+}
+
+
+void LpBoost::add_row(const AbstractWeakLearner &wl)
 {
 
     // The predictions are already pre-multiplied with the labels already
@@ -111,6 +151,12 @@ void LpBoost::update_examples_distribution(const AbstractWeakLearner &wl)
 
     delete new_row;
     delete new_row_index;
+    return;
+}
+
+
+void LpBoost::solve_examples_distribution()
+{
 
     // solve in the primal
     solver.primal();
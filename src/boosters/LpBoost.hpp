@@ -41,9 +41,20 @@ protected:
   
   void update_linear_ensemble(const AbstractWeakLearner& wl);
 
+  /// All the rows are added before a single solve
+  void add_weak_learners(const std::vector<AbstractWeakLearner*>& wls);
+
+  /// Add the edge constraint of the weak learner
+  void add_row(const AbstractWeakLearner& wl);
+
+  /// Solve, then read back the distribution and the weights of the model
+  void solve_examples_distribution();
+
   bool stopping_criterion(std::ostream& os);
 
   void update_stopping_criterion(const AbstractWeakLearner& wl);
+
+  void fill_iteration_record(IterationRecord& record) const;
   
 public:
 
@@ -53,6 +64,9 @@ public:
            const double epsilon,
            const double nu);
   ~LpBoost(void);
+
+  /// The cap of d_i becomes multiplicities[i]/nu
+  void set_example_multiplicities(const DenseVector& multiplicities);
   
 };
 
@@ -0,0 +1,234 @@
+#include "SuccessiveHalving.hpp"
+
+#include "boosters_factory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+ParameterSearchCandidate::ParameterSearchCandidate(const ConfigFile &config_,
+                                                   const std::string &description_)
+    : config(config_), description(description_),
+      validation_error(1.0), rung(0)
+{
+    // nothing to do here
+    return;
+}
+
+
+/// Sort helper, best candidates first
+bool lower_validation_error(const ParameterSearchCandidate &a, const ParameterSearchCandidate &b)
+{
+    return a.validation_error < b.validation_error;
+}
+
+
+/// Split a white space separated list of values
+std::vector<std::string> split_values(const std::string &values)
+{
+    std::vector<std::string> result;
+    std::istringstream values_stream(values);
+    std::string value;
+    while(values_stream >> value)
+    {
+        result.push_back(value);
+    }
+    return result;
+}
+
+
+SuccessiveHalving::SuccessiveHalving(const ConfigFile &config_,
+                                     const std::vector<int> &labels_,
+                                     const boost::shared_ptr<AbstractOracle> &oracle_,
+                                     const std::vector<SparseVector> &validation_data_,
+                                     const std::vector<int> &validation_labels_,
+                                     std::ostream &boosters_log_stream_)
+    : config(config_), labels(labels_), oracle(oracle_),
+      validation_data(validation_data_), validation_labels(validation_labels_),
+      boosters_log_stream(boosters_log_stream_),
+      total_iterations(0)
+{
+    if(not oracle)
+    {
+        throw std::invalid_argument("SuccessiveHalving requires an initialized oracle");
+    }
+
+    config.readInto(max_iterations, "max_iter");
+    config.readInto(min_iterations, "halving_min_iterations", 100);
+    config.readInto(halving_factor, "halving_factor", 3);
+    config.readInto(num_brackets, "halving_brackets", 1);
+
+    if(min_iterations <= 0 or halving_factor < 2 or num_brackets < 1)
+    {
+        throw std::invalid_argument("SuccessiveHalving requires "
+                                    "halving_min_iterations > 0, halving_factor >= 2 and halving_brackets >= 1");
+    }
+
+    min_iterations = std::min(min_iterations, max_iterations);
+    return;
+}
+
+
+SuccessiveHalving::~SuccessiveHalving()
+{
+    // nothing to do here
+    return;
+}
+
+
+std::vector<ParameterSearchCandidate> SuccessiveHalving::create_candidates() const
+{
+    const char *search_keys[] = {"eta", "nu", "D"};
+    const size_t num_search_keys = sizeof(search_keys)/sizeof(search_keys[0]);
+
+    std::vector<ParameterSearchCandidate> candidates;
+    candidates.push_back(ParameterSearchCandidate(config, ""));
+    candidates.back().config.add("max_iter", max_iterations);
+
+    for(size_t k = 0; k < num_search_keys; k++)
+    {
+        std::string values_string;
+        config.readInto(values_string, std::string("search_") + search_keys[k], std::string());
+        const std::vector<std::string> values = split_values(values_string);
+
+        if(values.empty())
+        {
+            continue;
+        }
+
+        // cartesian product with the values of this key
+        std::vector<ParameterSearchCandidate> new_candidates;
+        for(size_t c = 0; c < candidates.size(); c++)
+        {
+            for(size_t v = 0; v < values.size(); v++)
+            {
+                ParameterSearchCandidate candidate(candidates[c]);
+                candidate.config.add(search_keys[k], values[v]);
+                candidate.description += std::string(search_keys[k]) + " = " + values[v] + " ";
+                new_candidates.push_back(candidate);
+            }
+        }
+        candidates.swap(new_candidates);
+    }
+
+    return candidates;
+}
+
+
+void SuccessiveHalving::advance(ParameterSearchCandidate &candidate, const int iterations_budget)
+{
+    if(not candidate.booster)
+    {
+        candidate.booster.reset(new_booster_instance(candidate.config, labels, oracle, boosters_log_stream));
+        candidate.validation_margins.reset(new IncrementalMargins(validation_data, validation_labels));
+    }
+
+    AbstractBooster &booster = *candidate.booster;
+    const int iterations_before = booster.get_num_iterations();
+    booster.boost_iterations(iterations_budget - iterations_before, boosters_log_stream);
+    total_iterations += booster.get_num_iterations() - iterations_before;
+
+    candidate.validation_margins->update(booster.get_ensemble());
+    candidate.validation_error = candidate.validation_margins->error();
+    return;
+}
+
+
+ParameterSearchCandidate SuccessiveHalving::run_bracket(const int initial_iterations,
+                                                        const size_t num_configurations,
+                                                        std::ostream &log_stream)
+{
+    const std::vector<ParameterSearchCandidate> candidates = create_candidates();
+    std::vector<ParameterSearchCandidate> alive;
+    for(size_t k = 0; k < num_configurations; k++)
+    {
+        alive.push_back(candidates[k*candidates.size()/num_configurations]);
+    }
+
+    int iterations_budget = initial_iterations;
+    for(int rung = 0; ; rung++)
+    {
+        for(size_t c = 0; c < alive.size(); c++)
+        {
+            advance(alive[c], iterations_budget);
+            alive[c].rung = rung;
+        }
+
+        std::stable_sort(alive.begin(), alive.end(), lower_validation_error);
+
+        log_stream << "Rung " << rung << " (" << iterations_budget << " iterations): " << std::endl;
+        for(size_t c = 0; c < alive.size(); c++)
+        {
+            log_stream << "    " << alive[c].description
+                       << "validation error " << alive[c].validation_error
+                       << (alive[c].booster->is_finished()? " (finished)" : "") << std::endl;
+        }
+
+        if(alive.size() == 1 or iterations_budget >= max_iterations)
+        {
+            break;
+        }
+
+        // kill the bottom fraction, this frees the boosters memory
+        const size_t num_survivors = std::max<size_t>(1, alive.size()/halving_factor);
+        alive.resize(num_survivors, alive[0]);
+
+        iterations_budget = std::min(max_iterations, iterations_budget*halving_factor);
+    }
+
+    return alive[0];
+}
+
+
+ParameterSearchCandidate SuccessiveHalving::search(std::ostream &log_stream)
+{
+    const size_t num_candidates = create_candidates().size();
+
+    // halvings from min_iterations to max_iterations
+    int s_max = 0;
+    for(long r = min_iterations; r*halving_factor <= max_iterations; r *= halving_factor)
+    {
+        s_max++;
+    }
+    const int brackets = std::min(num_brackets, s_max + 1);
+
+    log_stream << "Successive halving over " << num_candidates << " configurations, "
+               << brackets << " bracket(s)" << std::endl;
+
+    std::vector<ParameterSearchCandidate> bracket_winners;
+    int initial_iterations = min_iterations;
+    for(int bracket = 0; bracket < brackets; bracket++)
+    {
+        // Hyperband: fewer configurations as the first rung grows
+        const int s = s_max - bracket;
+        const double num_configurations = std::ceil(num_candidates*(s_max + 1.0)
+                                                    /((s + 1.0)*std::pow(double(halving_factor), s_max - s)));
+        const size_t bracket_size = std::min(num_candidates, static_cast<size_t>(num_configurations));
+
+        log_stream << "Bracket " << bracket << ", " << bracket_size << " configurations, first rung with "
+                   << initial_iterations << " iterations" << std::endl;
+        bracket_winners.push_back(run_bracket(initial_iterations, bracket_size, log_stream));
+        initial_iterations = std::min(max_iterations, initial_iterations*halving_factor);
+    }
+
+    std::stable_sort(bracket_winners.begin(), bracket_winners.end(), lower_validation_error);
+
+    log_stream << "Best configuration: " << bracket_winners[0].description
+               << "validation error " << bracket_winners[0].validation_error << std::endl;
+    log_stream << "Boosting iterations used: " << total_iterations
+               << " (full grid: " << num_candidates*max_iterations << ")" << std::endl;
+
+    return bracket_winners[0];
+}
+
+
+long SuccessiveHalving::get_total_iterations() const
+{
+    return total_iterations;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,127 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_SUCCESSIVEHALVING_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_SUCCESSIVEHALVING_HPP
+
+#include "AbstractBooster.hpp"
+#include "IncrementalMargins.hpp"
+#include "ConfigFile.hpp"
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace totally_corrective_boosting
+{
+
+/// One point of the parameter grid explored by SuccessiveHalving
+class ParameterSearchCandidate
+{
+public:
+
+    /// Base configuration overridden with the candidate parameters
+    ConfigFile config;
+
+    /// Human readable list of the overridden parameters
+    std::string description;
+
+    boost::shared_ptr<AbstractBooster> booster;
+    boost::shared_ptr<IncrementalMargins> validation_margins;
+
+    double validation_error;
+
+    /// Last rung reached by this candidate
+    int rung;
+
+    ParameterSearchCandidate(const ConfigFile &config, const std::string &description);
+};
+
+
+/// Successive halving (and Hyperband) scheduler for the boosters parameters.
+///
+/// All the candidate configurations are boosted for a few iterations,
+/// evaluated on the validation set, the worst ones are killed and the
+/// survivors continue from their in-memory state for a larger budget.
+///
+/// The explored grid is the cartesian product of the (white space
+/// separated) values of the search_eta, search_nu and search_D keys.
+///
+/// Hyperband runs halving_brackets successive halving brackets. With
+/// s_max halvings from halving_min_iterations to max_iter, bracket s
+/// (s = s_max, s_max - 1, ...) starts n_s configurations with
+/// halving_min_iterations*halving_factor^(s_max - s) iterations each,
+/// n_s = ceil(N (s_max + 1)/(s + 1) halving_factor^(s - s_max)) of the N
+/// grid points (evenly spaced in the grid): the first bracket is plain
+/// successive halving over the full grid, the budget of every bracket
+/// is about the same.
+///
+/// L. Li, K. Jamieson, G. DeSalvo, A. Rostamizadeh and A. Talwalkar,
+/// Hyperband: A Novel Bandit-Based Approach to Hyperparameter Optimization,
+/// JMLR 18, 2018.
+class SuccessiveHalving
+{
+
+protected:
+
+    const ConfigFile &config;
+
+    const std::vector<int> &labels;
+
+    /// The oracles are stateless, all candidates share the same one
+    const boost::shared_ptr<AbstractOracle> oracle;
+
+    const std::vector<SparseVector> &validation_data;
+    const std::vector<int> &validation_labels;
+
+    /// Iterations budget of the first rung
+    int min_iterations;
+
+    /// Maximum number of iterations for a single configuration
+    int max_iterations;
+
+    /// Only 1/halving_factor of the candidates survive each rung
+    int halving_factor;
+
+    /// Number of Hyperband brackets (1 means plain successive halving),
+    /// at most the number of halvings from min_iterations to max_iterations, plus 1
+    int num_brackets;
+
+    /// Log stream used by the candidate boosters
+    std::ostream &boosters_log_stream;
+
+    /// Total number of boosting iterations run over all the candidates
+    long total_iterations;
+
+    std::vector<ParameterSearchCandidate> create_candidates() const;
+
+    /// Run one successive halving bracket over num_configurations evenly
+    /// spaced points of the grid
+    /// @returns the best candidate of the bracket
+    ParameterSearchCandidate run_bracket(const int initial_iterations,
+                                         const size_t num_configurations,
+                                         std::ostream &log_stream);
+
+    void advance(ParameterSearchCandidate &candidate, const int iterations_budget);
+
+public:
+
+    SuccessiveHalving(const ConfigFile &config,
+                      const std::vector<int> &labels,
+                      const boost::shared_ptr<AbstractOracle> &oracle,
+                      const std::vector<SparseVector> &validation_data,
+                      const std::vector<int> &validation_labels,
+                      std::ostream &boosters_log_stream);
+
+    ~SuccessiveHalving();
+
+    /// Run the search
+    /// @returns the best candidate found, with its booster in its final state
+    ParameterSearchCandidate search(std::ostream &log_stream = std::cout);
+
+    long get_total_iterations() const;
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_SUCCESSIVEHALVING_HPP
@@ -10,9 +10,11 @@
 #endif
 
 #include "optimizers/optimizers_factory.hpp"
+#include "math/vector_operations.hpp"
 
 #include <cmath>
 #include <stdexcept>
+#include <string>
 
 namespace totally_corrective_boosting
 {
@@ -22,12 +24,30 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
                                       const boost::shared_ptr<AbstractOracle> &oracle,
                                       std::ostream &log_stream)
 {
+    return new_booster_instance(config, labels, DenseVector(labels.size(), 1.0), oracle, log_stream);
+}
+
+
+AbstractBooster *new_booster_instance(const ConfigFile &config,
+                                      const std::vector<int> &labels,
+                                      const DenseVector &multiplicities,
+                                      const boost::shared_ptr<AbstractOracle> &oracle,
+                                      std::ostream &log_stream)
+{
 
     if(not oracle)
     {
         throw std::runtime_error("new_booster_instance requires an initialized oracle");
     }
 
+    if(multiplicities.dim != labels.size())
+    {
+        throw std::invalid_argument("new_booster_instance needs one multiplicity per example");
+    }
+
+    // eta depends on the number of examples, copies included
+    const double num_examples = sum(multiplicities);
+
     std::string booster_type;
     config.readInto(booster_type, "booster_type", std::string("ERLPBoost"));
 
@@ -64,11 +84,11 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
 
         if(binary)
         {
-            config.readInto(eta, "eta", 2.0*(1.0+std::log(labels.size()/nu))/epsilon);
+            config.readInto(eta, "eta", 2.0*(1.0+std::log(num_examples/nu))/epsilon);
         }
         else
         {
-            config.readInto(eta, "eta", 2.0*std::log(labels.size()/nu)/epsilon);
+            config.readInto(eta, "eta", 2.0*std::log(num_examples/nu)/epsilon);
         }
 
 
@@ -78,7 +98,7 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
         if(is_tKl_boost)
         {
             nu = tKlBoost::compute_nu(capital_dee);
-            eta = tKlBoost::compute_eta(labels.size(), epsilon, capital_dee);
+            eta = tKlBoost::compute_eta(static_cast<int>(num_examples), epsilon, capital_dee);
         }
 
         log_stream << "Maximum Iterations: " << max_iterations << std::endl;
@@ -93,20 +113,73 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
                                                binary,
                                                log_stream) );
 
+        ErlpBoost *erlp_booster = NULL;
         if(is_kl_boost)
         {
             std::cout << "Running Erlpboost (also known as KlBoost)" << std::endl;
-            ensemble_booster = new ErlpBoost(oracle, labels.size(), max_iterations, epsilon, eta, nu, binary, solver);
+            erlp_booster = new ErlpBoost(oracle, labels.size(), max_iterations, epsilon, eta, nu, binary, solver);
         }
         else if(is_tKl_boost)
         {
-            ensemble_booster = new tKlBoost(oracle, labels.size(), max_iterations, epsilon, capital_dee, binary, solver);
+            erlp_booster = new tKlBoost(oracle, labels.size(), max_iterations, epsilon, capital_dee, binary, solver);
         }
         else
         {
             throw std::runtime_error("This should never happen.");
         }
 
+        std::string solver_trace_filepath;
+        config.readInto(solver_trace_filepath, "solver_trace_file", std::string());
+        if(not solver_trace_filepath.empty())
+        {
+            if(num_examples != labels.size())
+            {
+                throw std::invalid_argument("solver_trace_file does not record the multiplicities "
+                                            "of deduplicated examples");
+            }
+            size_t traced_retire_after = 0;
+            config.readInto(traced_retire_after, "retire_after", size_t(0));
+            if(traced_retire_after > 0)
+            {
+                throw std::invalid_argument("solver_trace_file does not record the working set "
+                                            "of weak learners (retire_after > 0)");
+            }
+            log_stream << "Recording the solver problems to " << solver_trace_filepath << std::endl;
+            erlp_booster->record_solver_trace(solver_trace_filepath);
+        }
+
+        bool adaptive_tolerance = false;
+        config.readInto(adaptive_tolerance, "adaptive_tolerance", false);
+        if(adaptive_tolerance)
+        {
+            double adaptive_tolerance_factor = 0;
+            config.readInto(adaptive_tolerance_factor, "adaptive_tolerance_factor", 0.1);
+            log_stream << "Adaptive solver tolerance, factor " << adaptive_tolerance_factor << std::endl;
+            erlp_booster->set_adaptive_tolerance(adaptive_tolerance_factor);
+        }
+
+        size_t retire_after = 0;
+        config.readInto(retire_after, "retire_after", size_t(0));
+        if(retire_after > 0)
+        {
+            size_t verify_interval = 0;
+            config.readInto(verify_interval, "working_set_verify_interval", size_t(10));
+            log_stream << "Working set of weak learners, retired after " << retire_after
+                       << " solves at zero weight, verified every " << verify_interval << " solves" << std::endl;
+            solver->set_working_set(retire_after, verify_interval);
+        }
+
+        size_t weak_learners_per_iteration = 1;
+        config.readInto(weak_learners_per_iteration, "weak_learners_per_iteration", size_t(1));
+        if(weak_learners_per_iteration > 1)
+        {
+            log_stream << "Adding the " << weak_learners_per_iteration
+                       << " best weak learners per iteration" << std::endl;
+        }
+        erlp_booster->set_weak_learners_per_iteration(weak_learners_per_iteration);
+
+        ensemble_booster = erlp_booster;
+
     }
     else if(booster_type == "LPBoost")
     {
@@ -118,6 +191,10 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
         config.readInto(nu, "nu", 1.0);
 #ifdef USE_CLP
         ensemble_booster = new LpBoost(oracle, labels.size(), max_iterations, epsilon, nu);
+
+        size_t weak_learners_per_iteration = 1;
+        config.readInto(weak_learners_per_iteration, "weak_learners_per_iteration", size_t(1));
+        ensemble_booster->set_weak_learners_per_iteration(weak_learners_per_iteration);
 #else
         std::stringstream os;
         os << "You must compile with COIN-OR LP solver support enabled to use LPBoost"
@@ -143,7 +220,7 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
         config.readInto(linesearch, "linesearch", false);
 
         double eta = 0.0;
-        config.readInto(eta, "eta", 2.0*log(labels.size()/nu)/epsilon);
+        config.readInto(eta, "eta", 2.0*log(num_examples/nu)/epsilon);
 
         ensemble_booster = new CorrectiveBoost(oracle, labels.size(), max_iterations, epsilon, eta, nu, linesearch,10);
     }
@@ -153,6 +230,11 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
         throw std::runtime_error("Received an unknown value for booster_type");
     }
 
+    if(num_examples != labels.size())
+    {
+        ensemble_booster->set_example_multiplicities(multiplicities);
+    }
+
     return ensemble_booster;
 }
 
@@ -2,6 +2,7 @@
 #define TOTALLY_CORRECTIVE_BOOSTING_BOOSTERS_FACTORY_HPP
 
 #include "ConfigFile.hpp"
+#include "math/dense_vector.hpp"
 
 #include <boost/shared_ptr.hpp>
 
@@ -20,6 +21,14 @@ AbstractBooster *new_booster_instance(const ConfigFile &config,
                                       const boost::shared_ptr<AbstractOracle> &oracle,
                                       std::ostream &log_stream = std::cout);
 
+/// Same as above, example i stands for multiplicities[i] identical
+/// examples (see deduplicate_examples)
+AbstractBooster *new_booster_instance(const ConfigFile &config,
+                                      const std::vector<int> &labels,
+                                      const DenseVector &multiplicities,
+                                      const boost::shared_ptr<AbstractOracle> &oracle,
+                                      std::ostream &log_stream = std::cout);
+
 } // end of namespace totally_corrective_boosting
 
 #endif // TOTALLY_CORRECTIVE_BOOSTING_BOOSTERS_FACTORY_HPP
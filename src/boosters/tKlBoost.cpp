@@ -30,6 +30,14 @@ tKlBoost::~tKlBoost()
 }
 
 
+void tKlBoost::set_example_multiplicities(const DenseVector& multiplicities)
+{
+    ErlpBoost::set_example_multiplicities(multiplicities);
+    eta = compute_eta(static_cast<int>(sum(multiplicities)), epsilon, D);
+    return;
+}
+
+
 double tKlBoost::compute_nu(const double capital_dee)
 {
     const double
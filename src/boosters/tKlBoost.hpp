@@ -26,6 +26,9 @@ public:
              const boost::shared_ptr<AbstractOptimizer> &solver);
     ~tKlBoost();
 
+    /// eta depends on the number of examples, copies included
+    void set_example_multiplicities(const DenseVector& multiplicities);
+
     /// we define compute nu as static since it will be needed outside the class
     static double compute_nu(const double capital_dee);
 
@@ -0,0 +1,256 @@
+#include "capped_softmax.hpp"
+#include "pivot_partition.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+const size_t max_beta_iter = 100;
+const double beta_tol = 1e-12; // On sum_i d_i - 1
+
+/// Binary distribution for the offset beta
+/// (same safe evaluation as AbstractOptimizer::binary_function)
+/// @return the binary dual objective, mass is sum_i d_i and
+/// curvature sum_i d_i (1 - nu d_i/c_i)
+double binary_terms(const DenseVector& margins,
+                    const std::vector<double>& multiplicities,
+                    const double num_examples,
+                    const double eta,
+                    const double nu,
+                    const double beta,
+                    DenseVector& distribution,
+                    double& mass,
+                    double& curvature)
+{
+    const size_t n = margins.dim;
+    const double nu_d = nu/num_examples;
+    const double x_min = std::log(nu_d*std::numeric_limits<double>::epsilon()/(1 - nu_d));
+    const double x_max = std::log(nu_d/(std::numeric_limits<double>::epsilon()*(1 - nu_d)));
+
+    double objective = 0.0;
+    mass = 0.0;
+    curvature = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        // term and mass of one of the c_i copies
+        const double x = eta*(margins.val[i] + beta);
+        double term = 0.0, d = 0.0;
+        if(x < x_min)
+        {
+            term = ((1 - nu_d)/nu_d)*std::exp(x) + std::log(nu_d) - x;
+            d = 1.0/nu;
+        }
+        else if(x > x_max)
+        {
+            term = std::log(1 - nu_d);
+        }
+        else
+        {
+            const double t = (1.0 - nu_d)*std::exp(x)/nu_d;
+            term = log1p(t) + std::log(nu_d) - x;
+            d = 1.0/(nu*(1.0 + t));
+        }
+        const double c = multiplicities[i];
+        objective += c*term;
+        distribution.val[i] = c*d;
+        mass += c*d;
+        curvature += c*d*(1.0 - nu*d);
+    }
+
+    return objective/(nu*eta) + beta;
+}
+
+} // end of anonymous namespace
+
+
+CappedSoftmax::CappedSoftmax()
+    : num_examples(0.0), random_state(pivot_random_seed)
+{
+    // nothing to do here
+    return;
+}
+
+
+void CappedSoftmax::set_multiplicities(const DenseVector& multiplicities_)
+{
+    multiplicities.assign(multiplicities_.val, multiplicities_.val + multiplicities_.dim);
+    num_examples = 0.0;
+    for(size_t i = 0; i < multiplicities.size(); i++)
+    {
+        num_examples += multiplicities[i];
+    }
+    return;
+}
+
+
+void CappedSoftmax::check_multiplicities(const size_t n)
+{
+    if(multiplicities.size() != n)
+    {
+        assert(multiplicities.empty());
+        multiplicities.assign(n, 1.0);
+        num_examples = n;
+    }
+    return;
+}
+
+
+double CappedSoftmax::evaluate(const DenseVector& margins,
+                               const double eta,
+                               const double nu,
+                               DenseVector& distribution,
+                               double *psi)
+{
+    const size_t n = margins.dim;
+    assert(distribution.dim == n and n > 0);
+    check_multiplicities(n);
+    assert(nu >= 1.0 and nu <= num_examples);
+
+    // cap of one copy of an example
+    const double cap = 1.0/nu;
+
+    // Safe exponentiation, the largest value is 1
+    double shift = -std::numeric_limits<double>::max();
+    for(size_t i = 0; i < n; i++)
+    {
+        shift = std::max(shift, -eta*margins.val[i]);
+    }
+
+    double total = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        distribution.val[i] = std::exp(-eta*margins.val[i] - shift);
+        total += multiplicities[i]*distribution.val[i];
+    }
+
+    // d_i = c_i min(theta*exp(...), cap), with theta normalizing the
+    // uncapped entries to the mass left by the capped ones. The value v
+    // (among the values >= v, count copies of them, summing to sum) is
+    // capped iff (1 - count*cap) v > cap (total - sum), so the capped
+    // values are found by randomized pivoting, as in quickselect
+    double theta = 1.0/total;
+    double num_capped = 0.0;
+    double capped_sum = 0.0;
+    if(theta > cap)
+    {
+        values.assign(distribution.val, distribution.val + n);
+        value_multiplicities.assign(multiplicities.begin(), multiplicities.end());
+
+        // [begin, end) are the candidates, the values before begin are
+        // known to be capped (num_capped copies of them, summing to capped_sum)
+        size_t begin = 0, end = n;
+        while(begin < end)
+        {
+            size_t greater_end, equal_end;
+            double partial_count, partial_sum;
+            const double pivot = partition_at_random_pivot(values, &value_multiplicities, begin, end,
+                                                           random_state, greater_end, equal_end,
+                                                           partial_count, partial_sum);
+
+            const double count = num_capped + partial_count;
+            if(count*cap < 1.0
+               and (1.0 - count*cap)*pivot > cap*(total - capped_sum - partial_sum))
+            {
+                // pivot, its ties and all the larger values are capped
+                capped_sum += partial_sum;
+                num_capped = count;
+                begin = equal_end;
+            }
+            else
+            {
+                // the capped values are among the values larger than pivot
+                end = greater_end;
+            }
+        }
+        theta = (1.0 - num_capped*cap)/(total - capped_sum);
+    }
+
+    double psi_sum = 0.0;
+    for(size_t i = 0; i < n; i++)
+    {
+        // mass of one copy
+        const double d = theta*distribution.val[i];
+        double psi_i = 0.0;
+        if(d > cap)
+        {
+            psi_i = std::log(d/cap)/eta;
+            distribution.val[i] = multiplicities[i]*cap;
+        }
+        else
+        {
+            distribution.val[i] = multiplicities[i]*d;
+        }
+        psi_sum += multiplicities[i]*psi_i;
+        if(psi != NULL)
+        {
+            psi[i] = psi_i;
+        }
+    }
+
+    return (shift - std::log(num_examples) - std::log(theta))/eta + psi_sum/nu;
+}
+
+
+double CappedSoftmax::evaluate_binary(const DenseVector& margins,
+                                      const double eta,
+                                      const double nu,
+                                      DenseVector& distribution,
+                                      double& beta)
+{
+    const size_t n = margins.dim;
+    assert(distribution.dim == n and n > 0);
+    check_multiplicities(n);
+
+    // d_i = c_i/N when eta (m_i + beta) = 0, so sum_i d_i = 1 is bracketed
+    // by beta = -max m (all d_i >= c_i/N) and beta = -min m (all d_i <= c_i/N)
+    double max_margin = -std::numeric_limits<double>::max();
+    double min_margin = std::numeric_limits<double>::max();
+    for(size_t i = 0; i < n; i++)
+    {
+        max_margin = std::max(max_margin, margins.val[i]);
+        min_margin = std::min(min_margin, margins.val[i]);
+    }
+    double lower = -max_margin, upper = -min_margin;
+    beta = std::min(std::max(beta, lower), upper);
+
+    double objective = 0.0, mass = 0.0, curvature = 0.0;
+    for(size_t iter = 0; ; iter++)
+    {
+        objective = binary_terms(margins, multiplicities, num_examples, eta, nu, beta,
+                                 distribution, mass, curvature);
+
+        const double excess = mass - 1.0;
+        if(std::fabs(excess) <= beta_tol or iter + 1 >= max_beta_iter
+           or upper - lower <= std::numeric_limits<double>::epsilon()*(1.0 + std::fabs(beta)))
+        {
+            break;
+        }
+
+        // the mass decreases with beta
+        if(excess > 0.0)
+        {
+            lower = beta;
+        }
+        else
+        {
+            upper = beta;
+        }
+
+        double next = (curvature > 0.0)? beta + excess/(eta*curvature) : 0.5*(lower + upper);
+        if(not (next > lower and next < upper))
+        {
+            next = 0.5*(lower + upper);
+        }
+        beta = next;
+    }
+
+    return objective;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,76 @@
+#ifndef _CAPPED_SOFTMAX_HPP_
+#define _CAPPED_SOFTMAX_HPP_
+
+#include "dense_vector.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// The ERLPBoost distribution for given margins m = U w:
+/// d_i proportional to exp(-eta m_i)/N, capped at 1/nu.
+///
+/// This is the minimizer over psi >= 0 of the ERLPBoost dual
+///   (1/eta) log(sum_i exp(-eta (m_i + psi_i))/N) + sum_i psi_i/nu
+/// which is obtained in closed form: psi_i > 0 exactly on the capped
+/// entries. The capped entries are selected in expected linear time
+/// (randomized pivot, as in SimplexProjection), in a workspace kept
+/// between calls, nothing is allocated once it reached the largest size.
+///
+/// The binary ERLPBoost distribution is separable given the offset
+/// beta, d_i = 1/(nu (1 + (N/nu - 1) exp(eta (m_i + beta)))), and the
+/// optimal beta (sum_i d_i = 1) is found by safeguarded Newton steps.
+///
+/// With multiplicities (see deduplicate_examples), example i stands for
+/// c_i identical examples: d_i is their total mass, N = sum_i c_i and the
+/// cap is c_i/nu.
+class CappedSoftmax
+{
+
+protected:
+
+    /// Exponentials of the margins, partitioned in place (with their
+    /// multiplicities)
+    std::vector<double> values, value_multiplicities;
+
+    /// Of each example, 1 unless set_multiplicities was called
+    std::vector<double> multiplicities;
+
+    /// Sum of the multiplicities (N)
+    double num_examples;
+
+    /// All multiplicities 1 for n examples, unless they were set
+    void check_multiplicities(const size_t n);
+
+    /// xorshift state, picks the pivots
+    uint64_t random_state;
+
+public:
+
+    CappedSoftmax();
+
+    void set_multiplicities(const DenseVector& multiplicities);
+
+    /// Writes the distribution (and psi, if not NULL, of size margins.dim)
+    /// @return the dual objective at the optimal psi
+    double evaluate(const DenseVector& margins,
+                    const double eta,
+                    const double nu,
+                    DenseVector& distribution,
+                    double *psi = NULL);
+
+    /// Writes the binary distribution and the optimal beta
+    /// (beta is also the starting point of the search)
+    /// @return the binary dual objective at the optimal beta
+    double evaluate_binary(const DenseVector& margins,
+                           const double eta,
+                           const double nu,
+                           DenseVector& distribution,
+                           double& beta);
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // _CAPPED_SOFTMAX_HPP_
@@ -0,0 +1,66 @@
+#include "pivot_partition.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace totally_corrective_boosting
+{
+
+double partition_at_random_pivot(std::vector<double>& values,
+                                 std::vector<double>* weights,
+                                 const size_t begin, const size_t end,
+                                 uint64_t& random_state,
+                                 size_t& greater_end,
+                                 size_t& equal_end,
+                                 double& partial_weight,
+                                 double& partial_sum)
+{
+    assert(begin < end and end <= values.size());
+
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    const double pivot = values[begin + random_state % (end - begin)];
+
+    // three way partition (Dijkstra's Dutch national flag): [begin, greater)
+    // is > pivot, [greater, i) == pivot, [i, less) not seen yet, [less, end) < pivot
+    size_t greater = begin, i = begin, less = end;
+    partial_weight = 0.0;
+    partial_sum = 0.0;
+    while(i < less)
+    {
+        const double value = values[i];
+        if(value < pivot)
+        {
+            less -= 1;
+            std::swap(values[i], values[less]);
+            if(weights != NULL)
+            {
+                std::swap((*weights)[i], (*weights)[less]);
+            }
+            continue;
+        }
+
+        const double weight = (weights != NULL)? (*weights)[i] : 1.0;
+        partial_weight += weight;
+        partial_sum += weight*value;
+        if(value > pivot)
+        {
+            std::swap(values[i], values[greater]);
+            if(weights != NULL)
+            {
+                std::swap((*weights)[i], (*weights)[greater]);
+            }
+            greater += 1;
+        }
+        i += 1;
+    }
+
+    // the pivot itself is == pivot
+    assert(greater < less);
+    greater_end = greater;
+    equal_end = less;
+    return pivot;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,35 @@
+#ifndef _PIVOT_PARTITION_HPP_
+#define _PIVOT_PARTITION_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Seed of the xorshift state of partition_at_random_pivot
+const uint64_t pivot_random_seed = 0x9E3779B97F4A7C15ULL;
+
+/// One step of a randomized selection, as in quickselect (used by
+/// SimplexProjection and CappedSoftmax): picks a pivot among
+/// values[begin, end) with the xorshift random_state and splits them three
+/// ways, [begin, greater_end) > pivot, [greater_end, equal_end) == pivot and
+/// [equal_end, end) < pivot. The weights of the values (NULL for unit
+/// weights) are moved along.
+/// The ties of the pivot are kept together, so that the callers accept or
+/// reject them at once: the selection stays linear when values repeat.
+/// @return the pivot, partial_weight and partial_sum are the total weight
+/// and weighted sum of the values >= pivot
+double partition_at_random_pivot(std::vector<double>& values,
+                                 std::vector<double>* weights,
+                                 const size_t begin, const size_t end,
+                                 uint64_t& random_state,
+                                 size_t& greater_end,
+                                 size_t& equal_end,
+                                 double& partial_weight,
+                                 double& partial_sum);
+
+} // end of namespace totally_corrective_boosting
+
+#endif // _PIVOT_PARTITION_HPP_
@@ -0,0 +1,76 @@
+#include "simplex_projection.hpp"
+#include "pivot_partition.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace totally_corrective_boosting
+{
+
+SimplexProjection::SimplexProjection()
+    : random_state(pivot_random_seed)
+{
+    // nothing to do here
+    return;
+}
+
+
+double SimplexProjection::project(DenseVector& x,
+                                  const size_t skip_begin, const size_t skip_end,
+                                  const double radius)
+{
+    assert(skip_begin <= skip_end and skip_end <= x.dim);
+    assert(radius > 0);
+
+    values.clear();
+    values.insert(values.end(), x.val, x.val + skip_begin);
+    values.insert(values.end(), x.val + skip_end, x.val + x.dim);
+
+    if(values.empty())
+    {
+        return 0;
+    }
+
+    // [begin, end) are the candidates, the values before begin are
+    // known to be in the support (count of them, summing to support_sum)
+    size_t begin = 0, end = values.size();
+    size_t count = 0;
+    double support_sum = 0;
+    while(begin < end)
+    {
+        size_t greater_end, equal_end;
+        double partial_count, partial_sum;
+        const double pivot = partition_at_random_pivot(values, NULL, begin, end, random_state,
+                                                       greater_end, equal_end,
+                                                       partial_count, partial_sum);
+
+        if((support_sum + partial_sum) - (count + equal_end - begin)*pivot < radius)
+        {
+            // pivot, its ties and all the larger values are in the support
+            support_sum += partial_sum;
+            count += equal_end - begin;
+            begin = equal_end;
+        }
+        else
+        {
+            // the support is among the values larger than pivot
+            end = greater_end;
+        }
+    }
+
+    // the largest value is always in the support
+    assert(count > 0);
+    const double theta = (support_sum - radius)/count;
+
+    for(size_t i = 0; i < skip_begin; i++)
+    {
+        x.val[i] = std::max(x.val[i] - theta, 0.0);
+    }
+    for(size_t i = skip_end; i < x.dim; i++)
+    {
+        x.val[i] = std::max(x.val[i] - theta, 0.0);
+    }
+    return theta;
+}
+
+} // end of namespace totally_corrective_boosting
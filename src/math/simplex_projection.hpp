@@ -0,0 +1,46 @@
+#ifndef _SIMPLEX_PROJECTION_HPP_
+#define _SIMPLEX_PROJECTION_HPP_
+
+#include "dense_vector.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+/// Euclidean projection onto the simplex {x : sum x_i = radius, x_i >= 0},
+/// in expected linear time (randomized pivot, as in quickselect, see
+/// Duchi, Shalev-Shwartz, Singer and Chandra, "Efficient projections onto
+/// the l1-ball for learning in high dimensions", ICML 2008), also when
+/// values repeat: the ties of a pivot are accepted or rejected at once.
+///
+/// The values are partitioned in a workspace kept between calls,
+/// nothing is allocated once it reached the largest size.
+class SimplexProjection
+{
+
+protected:
+
+    /// Copy of the projected values, partitioned in place
+    std::vector<double> values;
+
+    /// xorshift state, picks the pivots
+    uint64_t random_state;
+
+public:
+
+    SimplexProjection();
+
+    /// Projects in place the coordinates of x outside [skip_begin, skip_end),
+    /// the others are not changed.
+    /// Upper bounds u_i >= radius would be implied, they need no handling.
+    /// @return the threshold theta, x_i = max(x_i - theta, 0)
+    double project(DenseVector& x,
+                   const size_t skip_begin, const size_t skip_end,
+                   const double radius);
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // _SIMPLEX_PROJECTION_HPP_
@@ -1,6 +1,8 @@
 
 #include "sparse_vector.hpp"
 
+#include <boost/functional/hash.hpp>
+
 #include <iostream>
 
 
@@ -13,7 +15,7 @@ std::ostream& operator << (std::ostream& os, const SparseVector& s)
     os << "(" << s.dim << ")" << " ";
     for(size_t i = 0; i < s.nnz; i++)
     {
-        os << "[" << s.index[i] << "]  "<< s.val[i];
+        os << "[" << s.index[i] << "]  "<< s.value(i);
         if (i != (s.nnz-1))
             os << "  ";
     }
@@ -83,10 +85,36 @@ std::istream& operator >> (std::istream& in, SparseVector& s)
 
 bool operator == (const SparseVector& s1, const SparseVector& s2)
 {
-    return (s1.dim == s2.dim) and
-            (s1.nnz == s2.nnz) and
-            std::equal(s1.val, s1.val+s1.nnz, s2.val) and
-            std::equal(s1.index, s1.index+s1.nnz, s2.index);
+    if((s1.dim != s2.dim) or
+       (s1.nnz != s2.nnz) or
+       not std::equal(s1.index, s1.index+s1.nnz, s2.index))
+    {
+        return false;
+    }
+    // either one may be pattern-only
+    for(size_t i = 0; i < s1.nnz; i++)
+    {
+        if(s1.value(i) != s2.value(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+size_t hash_value(const SparseVector& s)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, s.dim);
+    boost::hash_combine(seed, s.nnz);
+    for(size_t i = 0; i < s.nnz; i++)
+    {
+        boost::hash_combine(seed, s.index[i]);
+        // -0.0 == 0.0
+        boost::hash_combine(seed, (s.value(i) == 0.0)? 0.0 : s.value(i));
+    }
+    return seed;
 }
 
 
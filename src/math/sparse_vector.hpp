@@ -34,11 +34,14 @@ public:
     // Copy constructor
     SparseVector(const SparseVector& s): nnz(s.nnz), dim(s.dim)
     {
-        val = new double[nnz];
+        val = s.pattern_only()? NULL : new double[nnz];
         index = new size_t[nnz];
         for(size_t i = 0; i < nnz; i++)
         {
-            val[i] = s.val[i];
+            if(val != NULL)
+            {
+                val[i] = s.val[i];
+            }
             index[i] = s.index[i];
         }
         return;
@@ -87,16 +90,57 @@ public:
         if(index != NULL) delete [] index;
         dim = rhs.dim;
         nnz = rhs.nnz;
-        val = new double[nnz];
+        val = rhs.pattern_only()? NULL : new double[nnz];
         index = new size_t[nnz];
         for(size_t i = 0; i < nnz; i++)
         {
             index[i] = rhs.index[i];
-            val[i] = rhs.val[i];
+            if(val != NULL)
+            {
+                val[i] = rhs.val[i];
+            }
         }
         return *this;
     }
 
+    /// Pattern-only vector: val is NULL and every entry listed in index
+    /// is 1 (binary features), see drop_unit_values()
+    bool pattern_only() const
+    {
+        return (val == NULL) and (nnz > 0);
+    }
+
+    /// Entry k of val, 1 if the vector is pattern-only
+    double value(const size_t k) const
+    {
+        return (val == NULL)? 1.0 : val[k];
+    }
+
+    /// true if there are nonzero entries and all of them are 1
+    bool unit_values() const
+    {
+        for(size_t i = 0; i < nnz; i++)
+        {
+            if(value(i) != 1.0)
+            {
+                return false;
+            }
+        }
+        return nnz > 0;
+    }
+
+    /// If unit_values(), free val and keep the pattern only
+    /// @return true if the vector is pattern-only
+    bool drop_unit_values()
+    {
+        if(unit_values() and val != NULL)
+        {
+            delete[] val;
+            val = NULL;
+        }
+        return pattern_only();
+    }
+
     void reset()
     {
         if(val != NULL)
@@ -126,6 +170,9 @@ public:
 
 };
 
+/// Consistent with operator ==, for boost::hash
+size_t hash_value(const SparseVector& s);
+
 } // end of namespace totally_corrective_boosting
 
 # endif
@@ -503,4 +503,38 @@ double binary_relative_entropy(const DenseVector& d, const double& nu)
     return ent;
 }
 
+
+double relative_entropy(const DenseVector& d, const DenseVector& multiplicities)
+{
+    assert(multiplicities.dim == d.dim);
+    const double num_examples = sum(multiplicities);
+    double ent = 0.0;
+    for(size_t i = 0; i < d.dim; i ++)
+    {
+        if(d.val[i] != 0.0)
+        {
+            ent += (d.val[i]*log(d.val[i]*num_examples/multiplicities.val[i]));
+        }
+    }
+    return ent;
+}
+
+
+double binary_relative_entropy(const DenseVector& d, const DenseVector& multiplicities, const double& nu)
+{
+    assert(multiplicities.dim == d.dim);
+    const double num_examples = sum(multiplicities);
+    double ent = 0.0;
+    for(size_t i = 0; i < d.dim; i ++)
+    {
+        const double m = multiplicities.val[i];
+        if(d.val[i] != 0.0)
+            ent += (d.val[i]*log(d.val[i]*num_examples/m));
+
+        if( d.val[i] != (m/nu))
+            ent += ((m/nu) - d.val[i])*log(((m/nu) - d.val[i])/((m/nu)-(m/num_examples)));
+    }
+    return ent;
+}
+
 } // end of namespace totally_corrective_boosting
@@ -40,6 +40,14 @@ double relative_entropy(const DenseVector& d);
 /// Elements restricted to 1/nu
 double binary_relative_entropy(const DenseVector& d, const double& nu);
 
+/// Same as above when example i stands for multiplicities[i] identical
+/// examples (see deduplicate_examples): d_i is their total mass, the
+/// reference is multiplicities[i]/N and the cap multiplicities[i]/nu
+/// @{
+double relative_entropy(const DenseVector& d, const DenseVector& multiplicities);
+double binary_relative_entropy(const DenseVector& d, const DenseVector& multiplicities, const double& nu);
+/// @}
+
 void normalize(SparseVector& a);
 void normalize(DenseVector& a);
 
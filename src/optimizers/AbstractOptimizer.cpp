@@ -2,6 +2,8 @@
 #include "AbstractOptimizer.hpp"
 
 #include "math/vector_operations.hpp"
+#include "Profiler.hpp"
+#include "MemoryAccounting.hpp"
 
 #include <limits>
 #include <cmath>
@@ -13,6 +15,50 @@
 namespace totally_corrective_boosting
 {
 
+namespace
+{
+
+/// Term of example i in the binary ERLPBoost objective (see
+/// binary_function) for x = eta*(m_i + beta), writes d_i
+double binary_term(const double x,
+                   const double nu,
+                   const double nu_d,
+                   const double x_min,
+                   const double x_max,
+                   double& d)
+{
+    if(x < x_min)
+    {
+        d = 1.0/nu;
+        return ((1-nu_d)/nu_d)*exp(x) + log(nu_d) - x;
+    }
+    if(x > x_max)
+    {
+        d = 0.0;
+        return log(1-nu_d);
+    }
+    double tmp = (1.0 - nu_d)*exp(x)/nu_d;
+    d = 1.0/(nu*(1.0 + tmp));
+    return log_one_plus_x(tmp) + log(nu_d) - x;
+}
+
+/// ERLPBoost examples with eta*(m_i + psi_i) this far above the smallest
+/// one hold less than epsilon of the mass, they are pinned at d_i = 0
+double erlp_zero_limit(const double num_examples)
+{
+    return log(num_examples/std::numeric_limits<double>::epsilon());
+}
+
+/// Below this x = eta*(m_i + beta), the exp(x) term of binary_term() is
+/// under epsilon^2 and dropped for the screened examples
+double binary_capped_limit(const double nu_d)
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+    return log(nu_d*eps*eps/(1 - nu_d));
+}
+
+} // end of anonymous namespace
+
 double log_one_plus_x(const double& x)
 {
     if (x <= -1.0){
@@ -52,8 +98,18 @@ AbstractOptimizer::AbstractOptimizer(const size_t& dim,
                                      const double& epsilon,
                                      const bool& binary):
     gap(std::numeric_limits<double>::max()),
-    num_weak_learners(0), dim(dim), transposed(transposed),
-    eta(eta), nu(nu), epsilon(epsilon), binary(binary), edge(0.0), x(0),
+    screening_valid(false), active_evaluation(false), max_abs_u(0.0),
+    num_zero_examples(0), num_capped_examples(0), zero_multiplicity(0.0), capped_multiplicity(0.0),
+    zero_min_margin(0.0), capped_max_margin(0.0),
+    reference_min_example(0), reference_min_margin(0.0),
+    num_active_evaluations(0),
+    retire_after(0), verify_interval(0), num_updates_since_verify(0),
+    num_weak_learners(0), num_retired_columns(0), dim(dim), multiplicities(dim, 1.0), num_examples(dim),
+    weighted_examples(false),
+    transposed(transposed),
+    eta(eta), nu(nu), epsilon(epsilon), gap_tolerance(0.5*epsilon), binary(binary), edge(0.0),
+    num_iterations(0), num_function_evaluations(0), num_gradient_evaluations(0),
+    x(0),
     min_primal(std::numeric_limits<double>::max()),
     dual_obj(std::numeric_limits<double>::max()){
 
@@ -64,12 +120,20 @@ AbstractOptimizer::AbstractOptimizer(const size_t& dim,
     {
         x.resize(num_weak_learners + dim);
     }
+    MemoryAccounting::allocate(MemoryAccounting::optimizer_solution, MemoryAccounting::bytes(x));
+
     // Note: dist is still un-initialized at this point
     return;
 }
 
 AbstractOptimizer::~AbstractOptimizer()
 {
+    MemoryAccounting::release(MemoryAccounting::optimizer_solution, MemoryAccounting::bytes(x));
+    for(size_t i = 0; i < U.size(); i++)
+    {
+        MemoryAccounting::release(MemoryAccounting::optimizer_columns, MemoryAccounting::bytes(U[i]));
+    }
+
     // Give up reference to dist
     distribution.val = NULL;
     distribution.dim = 0;
@@ -82,6 +146,26 @@ void AbstractOptimizer::set_distribution(const DenseVector& _distribution)
     // dist is just a reference to the true array
     distribution.val = _distribution.val;
     distribution.dim = _distribution.dim;
+
+    // the screened entries of the distribution are not written again
+    screening_valid = false;
+    active_evaluation = false;
+    return;
+}
+
+
+void AbstractOptimizer::set_example_multiplicities(const DenseVector& multiplicities_)
+{
+    if(multiplicities_.dim != dim)
+    {
+        throw std::invalid_argument("AbstractOptimizer::set_example_multiplicities needs one multiplicity per example");
+    }
+    multiplicities = multiplicities_;
+    num_examples = sum(multiplicities);
+    weighted_examples = true;
+
+    screening_valid = false;
+    active_evaluation = false;
     return;
 }
 
@@ -125,6 +209,13 @@ void AbstractOptimizer::push_back(const SparseVector& u)
     }
 
     U.push_back(u_dense);
+    column_ids.push_back(column_ids.size() + retired_ids.size());
+    dead_solves.push_back(0);
+    for(size_t i = 0; i < u.nnz; i++)
+    {
+        max_abs_u = std::max(max_abs_u, std::fabs(u.val[i]));
+    }
+    MemoryAccounting::allocate(MemoryAccounting::optimizer_columns, MemoryAccounting::bytes(u_dense));
 
     // U.push_back(u);
 
@@ -132,6 +223,7 @@ void AbstractOptimizer::push_back(const SparseVector& u)
 
     // Increase size of x by one
     x.resize(x.dim + 1);
+    MemoryAccounting::allocate(MemoryAccounting::optimizer_solution, sizeof(double));
 
     // // svnvish: BUGBUG
     // // start off with uniform distribution
@@ -171,37 +263,573 @@ void AbstractOptimizer::push_back(const SparseVector& u)
     // reset the duality gap
     gap = std::numeric_limits<double>::max();
 
+    // the margins changed
+    screening_valid = false;
+    active_evaluation = false;
+
     return;
 }
 
 
-double AbstractOptimizer::erlp_function()
+void AbstractOptimizer::set_working_set(const size_t retire_after_, const size_t verify_interval_)
+{
+    retire_after = retire_after_;
+    verify_interval = std::max(verify_interval_, size_t(1));
+    return;
+}
+
+
+bool AbstractOptimizer::update_working_set()
+{
+    if(retire_after == 0)
+    {
+        return false;
+    }
+
+    // Edges at the solution: a column at zero weight is optimal as long
+    // as its edge does not exceed the max edge
+    std::vector<double> edges(num_weak_learners);
+    double max_edge = -std::numeric_limits<double>::max();
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        edges[j] = dot(U[j], distribution);
+        max_edge = std::max(max_edge, edges[j]);
+    }
+
+    bool restored = false;
+    num_updates_since_verify++;
+    if(not retired_ids.empty() and num_updates_since_verify >= verify_interval)
+    {
+        num_updates_since_verify = 0;
+
+        DenseVector column(dim);
+        for(size_t k = retired_ids.size(); k-- > 0; )
+        {
+            cold_storage->read(retired_keys[k], column);
+            const double retired_edge = dot(column, distribution);
+            if(retired_edge > max_edge)
+            {
+                restore_retired(k);
+                edges.push_back(retired_edge);
+                restored = true;
+            }
+        }
+    }
+
+    // The solvers stop short of exact zeros, a weight is dead when it moves
+    // eta*margin by less than Optimizer::dead_weight
+    const double dead_weight = Optimizer::dead_weight/(eta*std::max(max_abs_u, 1.0));
+
+    std::vector<size_t> positions;
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        const bool dead = (x.val[j] <= dead_weight and edges[j] < max_edge);
+        dead_solves[j] = dead? dead_solves[j] + 1 : 0;
+        if(dead_solves[j] >= retire_after)
+        {
+            positions.push_back(j);
+        }
+    }
+    // keep at least one column
+    if(positions.size() == num_weak_learners)
+    {
+        positions.pop_back();
+    }
+    if(not positions.empty())
+    {
+        retire_columns(positions);
+    }
+
+    return restored;
+}
+
+
+bool AbstractOptimizer::restore_column(const size_t id)
 {
-    function_timer.start();
+    for(size_t k = 0; k < retired_ids.size(); k++)
+    {
+        if(retired_ids[k] == id)
+        {
+            restore_retired(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+DenseVector AbstractOptimizer::get_weights() const
+{
+    DenseVector weights(column_ids.size() + retired_ids.size());
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        weights.val[column_ids[j]] = x.val[j];
+    }
+    return weights;
+}
+
+
+void AbstractOptimizer::retire_columns(const std::vector<size_t>& positions)
+{
+    if(not cold_storage)
+    {
+        cold_storage.reset(new ColumnStore());
+    }
+
+    // The kept columns (and their weights) move down over the retired ones
+    size_t kept = 0, r = 0;
+    double kept_weight = 0.0;
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        if(r < positions.size() and positions[r] == j)
+        {
+            retired_keys.push_back(cold_storage->write(U[j]));
+            retired_ids.push_back(column_ids[j]);
+            MemoryAccounting::release(MemoryAccounting::optimizer_columns, MemoryAccounting::bytes(U[j]));
+            r++;
+            continue;
+        }
+        std::swap(U[kept].val, U[j].val);
+        std::swap(U[kept].dim, U[j].dim);
+        column_ids[kept] = column_ids[j];
+        dead_solves[kept] = dead_solves[j];
+        x.val[kept] = x.val[j];
+        kept_weight += x.val[j];
+        kept++;
+    }
+    const size_t num_retired = num_weak_learners - kept;
+    U.resize(kept);
+    column_ids.resize(kept);
+    dead_solves.resize(kept);
+
+    // psi (or beta) follows w in x
+    DenseVector x_tmp(x.dim - num_retired);
+    for(size_t i = 0; i < kept; i++)
+    {
+        x_tmp.val[i] = (kept_weight > 0.0)? x.val[i]/kept_weight : 1.0/kept;
+    }
+    for(size_t i = num_weak_learners; i < x.dim; i++)
+    {
+        x_tmp.val[i - num_retired] = x.val[i];
+    }
+    std::swap(x.val, x_tmp.val);
+    std::swap(x.dim, x_tmp.dim);
+    MemoryAccounting::release(MemoryAccounting::optimizer_solution, num_retired*sizeof(double));
+
+    num_weak_learners = kept;
+    num_retired_columns += num_retired;
+
+    screening_valid = false;
+    active_evaluation = false;
+    return;
+}
+
+
+void AbstractOptimizer::restore_retired(const size_t k)
+{
+    U.push_back(DenseVector(dim));
+    cold_storage->read(retired_keys[k], U.back());
+    MemoryAccounting::allocate(MemoryAccounting::optimizer_columns, MemoryAccounting::bytes(U.back()));
+    for(size_t i = 0; i < dim; i++)
+    {
+        max_abs_u = std::max(max_abs_u, std::fabs(U.back().val[i]));
+    }
+    column_ids.push_back(retired_ids[k]);
+    dead_solves.push_back(0);
+
+    retired_ids[k] = retired_ids.back();
+    retired_keys[k] = retired_keys.back();
+    retired_ids.pop_back();
+    retired_keys.pop_back();
+
+    // A zero weight, w stays on the simplex
+    DenseVector x_tmp(x.dim + 1);
+    for(size_t i = 0; i < num_weak_learners; i++)
+    {
+        x_tmp.val[i] = x.val[i];
+    }
+    for(size_t i = num_weak_learners; i < x.dim; i++)
+    {
+        x_tmp.val[i + 1] = x.val[i];
+    }
+    std::swap(x.val, x_tmp.val);
+    std::swap(x.dim, x_tmp.dim);
+    MemoryAccounting::allocate(MemoryAccounting::optimizer_solution, sizeof(double));
+
+    num_weak_learners++;
+
+    // as in push_back
+    min_primal = std::numeric_limits<double>::max();
+    dual_obj = std::numeric_limits<double>::max();
+    gap = std::numeric_limits<double>::max();
+    screening_valid = false;
+    active_evaluation = false;
+    return;
+}
+
+
+void AbstractOptimizer::screen_examples(const DenseVector& margins)
+{
+    screening_valid = false;
+
+    // U is only gathered by columns
+    if(not transposed)
+    {
+        return;
+    }
+
+    // The active examples have lower <= m_i <= upper, d_i is pinned at 0
+    // above upper and (binary only) at 1/nu below lower
+    double lower = -std::numeric_limits<double>::max();
+    double upper = std::numeric_limits<double>::max();
+    if(binary)
+    {
+        // x_i = eta*(m_i + beta) past x_max gives d_i = 0 and a constant
+        // term, below binary_capped_limit() d_i = 1/nu and a term linear
+        // in m_i, summed with the column sums of U
+        const double beta = x.val[num_weak_learners];
+        const double nu_d = nu/num_examples;
+        const double x_max = log(nu_d/(std::numeric_limits<double>::epsilon()*(1- nu_d)));
+        upper = (x_max + Optimizer::screening_slack)/eta - beta;
+        lower = (binary_capped_limit(nu_d) - Optimizer::screening_slack)/eta - beta;
+    }
+    else
+    {
+        // d_i is proportional to exp(-eta*(m_i + psi_i)), negligible far
+        // enough above the smallest m_i + psi_i
+        const double *psi = x.val + num_weak_learners;
+        double psi_min = std::numeric_limits<double>::max();
+        double min_value = std::numeric_limits<double>::max();
+        for(size_t i = 0; i < dim; i++)
+        {
+            psi_min = std::min(psi_min, psi[i]);
+            if(margins.val[i] + psi[i] < min_value)
+            {
+                min_value = margins.val[i] + psi[i];
+                reference_min_example = i;
+            }
+        }
+        reference_min_margin = margins.val[reference_min_example];
+        upper = min_value - psi_min + (erlp_zero_limit(num_examples) + Optimizer::screening_slack)/eta;
+    }
+
+    // Usually nothing can be screened, which is found without the lists
+    size_t num_active = 0;
+    for(size_t i = 0; i < dim; i++)
+    {
+        num_active += (margins.val[i] >= lower and margins.val[i] <= upper);
+    }
+    if(num_active == dim)
+    {
+        return;
+    }
+
+    reference_w.assign(x.val, x.val + num_weak_learners);
+    active_examples.clear();
+    std::vector<size_t> capped_examples;
+    num_zero_examples = 0;
+    zero_multiplicity = capped_multiplicity = 0.0;
+    zero_min_margin = std::numeric_limits<double>::max();
+    capped_max_margin = -std::numeric_limits<double>::max();
+    for(size_t i = 0; i < dim; i++)
+    {
+        if(margins.val[i] > upper)
+        {
+            num_zero_examples++;
+            zero_multiplicity += multiplicities.val[i];
+            zero_min_margin = std::min(zero_min_margin, margins.val[i]);
+        }
+        else if(margins.val[i] < lower)
+        {
+            capped_examples.push_back(i);
+            capped_multiplicity += multiplicities.val[i];
+            capped_max_margin = std::max(capped_max_margin, margins.val[i]);
+        }
+        else
+        {
+            active_examples.push_back(i);
+        }
+    }
+    num_capped_examples = capped_examples.size();
+
+    capped_column_sums.assign(num_weak_learners, 0.0);
+    for(size_t j = 0; j < num_weak_learners and num_capped_examples > 0; j++)
+    {
+        double column_sum = 0.0;
+        if(weighted_examples)
+        {
+            for(size_t r = 0; r < num_capped_examples; r++)
+            {
+                column_sum += multiplicities.val[capped_examples[r]]*U[j].val[capped_examples[r]];
+            }
+        }
+        else
+        {
+            for(size_t r = 0; r < num_capped_examples; r++)
+            {
+                column_sum += U[j].val[capped_examples[r]];
+            }
+        }
+        capped_column_sums[j] = column_sum;
+    }
+
+    // The screened entries of the distribution are set by the full
+    // evaluation and left alone by the active ones
+    screening_valid = true;
+    return;
+}
+
+
+double AbstractOptimizer::margin_drift() const
+{
+    double drift = 0.0;
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        drift += std::fabs(x.val[j] - reference_w[j]);
+    }
+    return max_abs_u*drift;
+}
+
+
+void AbstractOptimizer::compute_active_margins()
+{
+    const size_t n = active_examples.size();
+    active_values.assign(n, 0.0);
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        const double w_j = x.val[j];
+        if(w_j == 0.0)
+        {
+            continue;
+        }
+        const double *u = U[j].val;
+        for(size_t r = 0; r < n; r++)
+        {
+            active_values[r] += w_j*u[active_examples[r]];
+        }
+    }
+    return;
+}
+
+
+void AbstractOptimizer::compute_full_margins()
+{
+    if(full_margins.dim != dim)
+    {
+        full_margins.resize(dim);
+    }
 
     DenseVector W;
     W.val = x.val;
     W.dim = num_weak_learners;
 
+    // since the booster stores U transpose do transpose dot
+    if(transposed)
+    {
+        std::fill(full_margins.val, full_margins.val + dim, 0.0);
+        for(size_t j = 0; j < num_weak_learners; j++)
+        {
+            axpy(W.val[j], U[j], full_margins, full_margins);
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < dim; i++)
+        {
+            full_margins.val[i] = dot(U[i], W);
+        }
+    }
+
+    // This is not a memory leak! (because W.val is only pointing to x.val)
+    W.val = NULL;
+    W.dim = 0;
+    return;
+}
+
+
+void AbstractOptimizer::active_edges(double *edges) const
+{
+    const size_t n = active_examples.size();
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        const double *u = U[j].val;
+        double edge_j = 0.0;
+        for(size_t r = 0; r < n; r++)
+        {
+            const size_t i = active_examples[r];
+            edge_j += u[i]*distribution.val[i];
+        }
+        if(binary)
+        {
+            edge_j += capped_column_sums[j]/nu;
+        }
+        edges[j] = edge_j;
+    }
+    return;
+}
+
+
+void AbstractOptimizer::negative_edges(double *edges)
+{
+    // since the booster stores U transpose do normal dot and not
+    // transpose dot
+    if(active_evaluation)
+    {
+        active_edges(edges);
+    }
+    else if(transposed)
+    {
+        for(size_t j = 0; j < num_weak_learners; j++)
+        {
+            edges[j] = dot(U[j], distribution);
+        }
+    }
+    else
+    {
+        std::fill(edges, edges + num_weak_learners, 0.0);
+        for(size_t i = 0; i < U.size(); i++)
+        {
+            const double d_i = distribution.val[i];
+            const double *u = U[i].val;
+            for(size_t j = 0; j < num_weak_learners; j++)
+            {
+                edges[j] += d_i*u[j];
+            }
+        }
+    }
+
+    edge = -std::numeric_limits<double>::max();
+    for(size_t j = 0; j < num_weak_learners; j++)
+    {
+        edge = std::max(edge, edges[j]);
+        edges[j] = -edges[j];
+    }
+    return;
+}
+
+
+double AbstractOptimizer::active_entropy() const
+{
+    // Same terms as relative_entropy and binary_relative_entropy
+    double ent = 0.0;
+    if(not weighted_examples)
+    {
+        for(size_t r = 0; r < active_examples.size(); r++)
+        {
+            const double d = distribution.val[active_examples[r]];
+            if(d != 0.0)
+            {
+                ent += d*log(d*dim);
+            }
+            if(binary and d != (1/nu))
+            {
+                ent += ((1/nu) - d)*log(((1/nu) - d)/((1/nu)-(1.0/dim)));
+            }
+        }
+
+        if(binary)
+        {
+            ent += num_capped_examples*(1/nu)*log(dim/nu);
+            ent += num_zero_examples*(1/nu)*log((1/nu)/((1/nu)-(1.0/dim)));
+        }
+        return ent;
+    }
+
+    for(size_t r = 0; r < active_examples.size(); r++)
+    {
+        const double d = distribution.val[active_examples[r]];
+        const double m = multiplicities.val[active_examples[r]];
+        if(d != 0.0)
+        {
+            ent += d*log(d*num_examples/m);
+        }
+        if(binary and d != (m/nu))
+        {
+            ent += ((m/nu) - d)*log(((m/nu) - d)/((m/nu)-(m/num_examples)));
+        }
+    }
+
+    if(binary)
+    {
+        ent += capped_multiplicity*(1/nu)*log(num_examples/nu);
+        ent += zero_multiplicity*(1/nu)*log((1/nu)/((1/nu)-(1.0/num_examples)));
+    }
+    return ent;
+}
+
+
+double AbstractOptimizer::erlp_function()
+{
+    PROFILE_SCOPE(Profiler::solver_function);
+    num_function_evaluations += 1;
+
     // psi is obtained by simply offsetting num_wl elements of x
     // Whatever is left is psi
     double* psi = x.val + num_weak_learners;
     double psi_sum = 0.0;
+    double psi_min = std::numeric_limits<double>::max();
     for(size_t i = 0; i < dim; i++)
     {
-        psi_sum += psi[i];
+        psi_sum += weighted_examples? multiplicities.val[i]*psi[i] : psi[i];
+        psi_min = std::min(psi_min, psi[i]);
     }
 
-    DenseVector tmp_distribution;
-    // since the booster stores U transpose do transpose dot
-    if(transposed)
-    {
-        transpose_dot(U, W, tmp_distribution);
-    }
-    else
+    // The screened examples stay pinned as long as their m_i + psi_i
+    // (at least zero_min_margin - drift + psi_min) stays far enough
+    // above the smallest one (at most that of reference_min_example)
+    if(screening_valid)
     {
-        dot(U, W, tmp_distribution);
+        const double drift = margin_drift();
+        const double lowest_screened = zero_min_margin - drift + psi_min;
+        const double smallest = reference_min_margin + drift + psi[reference_min_example];
+        if(eta*(lowest_screened - smallest) > erlp_zero_limit(num_examples))
+        {
+            compute_active_margins();
+            const size_t n = active_examples.size();
+
+            double exp_max = -std::numeric_limits<double>::max();
+            for(size_t r = 0; r < n; r++)
+            {
+                active_values[r] = -eta*(active_values[r] + psi[active_examples[r]]);
+                exp_max = std::max(exp_max, active_values[r]);
+            }
+
+            dual_obj = 0.0;
+            for(size_t r = 0; r < n; r++)
+            {
+                const size_t i = active_examples[r];
+                if(weighted_examples)
+                {
+                    distribution.val[i] = multiplicities.val[i]*exp(active_values[r] - exp_max)/num_examples;
+                }
+                else
+                {
+                    distribution.val[i] = exp(active_values[r] - exp_max)/dim;
+                }
+                dual_obj += distribution.val[i];
+            }
+
+            const double normalization = 1.0/dual_obj;
+            for(size_t r = 0; r < n; r++)
+            {
+                distribution.val[active_examples[r]] *= normalization;
+            }
+
+            dual_obj += 1e-10;
+            dual_obj = (log(dual_obj)+ exp_max)/eta;
+            dual_obj += (psi_sum/nu);
+
+            active_evaluation = true;
+            num_active_evaluations += 1;
+            return dual_obj;
+        }
     }
+    active_evaluation = false;
+
+    compute_full_margins();
+    DenseVector& tmp_distribution = full_margins;
+
+    screen_examples(tmp_distribution);
 
     // Find max element
     double exp_max = -std::numeric_limits<double>::max();
@@ -218,21 +846,38 @@ double AbstractOptimizer::erlp_function()
     dual_obj = 0.0;
     for(size_t i = 0; i < tmp_distribution.dim; i++)
     {
-        distribution.val[i] = exp(tmp_distribution.val[i] - exp_max)/dim;
+        if(weighted_examples)
+        {
+            distribution.val[i] = multiplicities.val[i]*exp(tmp_distribution.val[i] - exp_max)/num_examples;
+        }
+        else
+        {
+            distribution.val[i] = exp(tmp_distribution.val[i] - exp_max)/dim;
+        }
         dual_obj += distribution.val[i];
     }
 
     scale(distribution, 1.0/dual_obj);
 
+    // Pin the screened examples, as the next active evaluations see them
+    if(screening_valid)
+    {
+        size_t r = 0;
+        for(size_t i = 0; i < dim; i++)
+        {
+            if(r < active_examples.size() and active_examples[r] == i)
+            {
+                r++;
+                continue;
+            }
+            distribution.val[i] = 0.0;
+        }
+    }
+
     dual_obj += 1e-10;
     dual_obj = (log(dual_obj)+ exp_max)/eta;
     dual_obj += (psi_sum/nu);
 
-    // This is not a memory leak! (because W.val is only pointing to x.val)
-    W.val = NULL;
-    W.dim = 0;
-
-    function_timer.stop();
     return dual_obj;
 }
 
@@ -252,39 +897,19 @@ double AbstractOptimizer::function()
 }
 
 
-DenseVector AbstractOptimizer::erlp_gradient()
+void AbstractOptimizer::erlp_gradient(double *grad)
 {
-    gradient_timer.start();
-    DenseVector grad_w;
-
-    // since the booster stores U transpose do normal dot and not
-    // transpose dot
-    if(transposed)
-    {
-        dot(U, distribution, grad_w);
-    }
-    else
-    {
-        transpose_dot(U, distribution, grad_w);
-    }
-
-    edge = max(grad_w);
-    // Adjust the gradient
-    scale(grad_w, -1.0);
-
-    DenseVector grad(num_weak_learners + dim);
+    PROFILE_SCOPE(Profiler::solver_gradient);
+    num_gradient_evaluations += 1;
 
-    // copy grad_w
-    for(size_t i = 0; i < num_weak_learners; i++)
-    {
-        grad.val[i] = grad_w.val[i];
-    }
+    // grad_w = -U'd
+    negative_edges(grad);
 
-
-    // set grad_psi = -dist + 1.0/nu
+    // set grad_psi = -dist + multiplicity/nu
     for(size_t i = 0; i < dim; i++)
     {
-        grad.val[i+num_weak_learners] = (1.0/nu) - distribution.val[i];
+        const double cap = weighted_examples? multiplicities.val[i]/nu : 1.0/nu;
+        grad[i+num_weak_learners] = cap - distribution.val[i];
     }
 
     // The lowest primal objective we have seen so far
@@ -293,8 +918,7 @@ DenseVector AbstractOptimizer::erlp_gradient()
     // duality gap w.r.t last known function value
     gap = min_primal + dual_obj;
 
-    gradient_timer.stop();
-    return grad;
+    return;
 }
 
 // Return gradient of objective function 
@@ -302,15 +926,24 @@ DenseVector AbstractOptimizer::erlp_gradient()
 // compute duality gap as a side effect 
 // Just a dummy forwarding function 
 DenseVector AbstractOptimizer::gradient()
+{
+    DenseVector grad(x.dim);
+    gradient(grad.val);
+    return grad;
+}
+
+
+void AbstractOptimizer::gradient(double *grad)
 {
     if(binary)
     {
-        return binary_gradient();
+        binary_gradient(grad);
     }
     else
     {
-        return erlp_gradient();
+        erlp_gradient(grad);
     }
+    return;
 }
 
 // Return primal objective function 
@@ -318,19 +951,42 @@ DenseVector AbstractOptimizer::gradient()
 // to grad  
 double AbstractOptimizer::primal()
 {
+    if(active_evaluation)
+    {
+        return edge + (active_entropy()/eta);
+    }
+
+    if(not weighted_examples)
+    {
+        return edge + ((binary? binary_relative_entropy(distribution, nu) : relative_entropy(distribution))/eta);
+    }
+
     if(binary)
     {
-        return edge + (binary_relative_entropy(distribution, nu)/eta);
+        return edge + (binary_relative_entropy(distribution, multiplicities, nu)/eta);
     }
 
-    return edge + (relative_entropy(distribution)/eta);
+    return edge + (relative_entropy(distribution, multiplicities)/eta);
 
 }
 
 bool AbstractOptimizer::duality_gap_met()
 {
     // return gap < 0.05*epsilon;
-    return gap < 0.5*epsilon;
+    return gap < gap_tolerance;
+}
+
+
+void AbstractOptimizer::set_gap_tolerance(const double tolerance)
+{
+    gap_tolerance = std::max(tolerance, 0.5*epsilon);
+    return;
+}
+
+
+double AbstractOptimizer::get_gap_tolerance() const
+{
+    return gap_tolerance;
 }
 
 
@@ -338,30 +994,68 @@ bool AbstractOptimizer::duality_gap_met()
 double AbstractOptimizer::binary_function()
 {
 
-    function_timer.start();
-    DenseVector W;
-    W.val = x.val;
-    W.dim = num_weak_learners;
+    PROFILE_SCOPE(Profiler::solver_function);
+    num_function_evaluations += 1;
 
     // beta is last element of x
     double beta = x.val[num_weak_learners];
 
-    DenseVector tmp_dist;
+    double nu_d = nu/num_examples;
+    double x_min = log(nu_d*std::numeric_limits<double>::epsilon()/(1- nu_d));
+    double x_max = log(nu_d/(std::numeric_limits<double>::epsilon()*(1- nu_d)));
 
-    // since the booster stores U transpose do transpose dot
-    if(transposed)
+    // The screened examples stay past x_max (resp. below
+    // binary_capped_limit()) as long as their margins do, up to the drift
+    if(screening_valid)
     {
-        transpose_dot(U, W, tmp_dist);
-    }
-    else
-    {
-        dot(U, W, tmp_dist);
+        const double drift = margin_drift();
+        if((num_zero_examples == 0 or eta*(zero_min_margin - drift + beta) > x_max)
+           and (num_capped_examples == 0
+                or eta*(capped_max_margin + drift + beta) < binary_capped_limit(nu_d)))
+        {
+            compute_active_margins();
+
+            dual_obj = 0.0;
+            for(size_t r = 0; r < active_examples.size(); r++)
+            {
+                const size_t i = active_examples[r];
+                const double term = binary_term(eta*(active_values[r] + beta), nu, nu_d,
+                                                x_min, x_max, distribution.val[i]);
+                if(weighted_examples)
+                {
+                    dual_obj += multiplicities.val[i]*term;
+                    distribution.val[i] *= multiplicities.val[i];
+                }
+                else
+                {
+                    dual_obj += term;
+                }
+            }
+
+            // d_i = 0 and 1/nu on the screened examples, the sum of their
+            // margins is w'(column sums)
+            double capped_margin_sum = 0.0;
+            for(size_t j = 0; j < num_weak_learners; j++)
+            {
+                capped_margin_sum += x.val[j]*capped_column_sums[j];
+            }
+            dual_obj += zero_multiplicity*log(1-nu_d);
+            dual_obj += capped_multiplicity*log(nu_d) - eta*(capped_margin_sum + capped_multiplicity*beta);
+
+            dual_obj /= (nu*eta);
+            dual_obj += beta;
+
+            active_evaluation = true;
+            num_active_evaluations += 1;
+            return dual_obj;
+        }
     }
+    active_evaluation = false;
 
+    compute_full_margins();
+    DenseVector& tmp_dist = full_margins;
 
-    // This is not a memory leak!
-    W.val = NULL;
-    W.dim = 0;
+    screen_examples(tmp_dist);
 
     // We want to compute:
     // f(x) = log(1 - nu.d + nu.d.exp(-x))
@@ -404,64 +1098,52 @@ double AbstractOptimizer::binary_function()
     // For the rest we compute things explicitly
 
     dual_obj = 0.0;
-    double nu_d = nu/dim;
-    double x_min = log(nu_d*std::numeric_limits<double>::epsilon()/(1- nu_d));
-    double x_max = log(nu_d/(std::numeric_limits<double>::epsilon()*(1- nu_d)));
-
     for(size_t i = 0; i < tmp_dist.dim; i++)
     {
-        tmp_dist.val[i] = eta*(tmp_dist.val[i] + beta);
-        if(tmp_dist.val[i] < x_min)
+        const double term = binary_term(eta*(tmp_dist.val[i] + beta), nu, nu_d,
+                                        x_min, x_max, distribution.val[i]);
+        if(weighted_examples)
         {
-            dual_obj += ((1-nu_d)/nu_d)*exp(tmp_dist.val[i]) + log(nu_d) - tmp_dist.val[i];
-            distribution.val[i] = 1.0/nu;
-            continue;
+            dual_obj += multiplicities.val[i]*term;
+            distribution.val[i] *= multiplicities.val[i];
         }
-        if(tmp_dist.val[i] > x_max)
+        else
         {
-            dual_obj += log(1-nu_d);
-            distribution.val[i] = 0.0;
-            continue;
+            dual_obj += term;
         }
-        double tmp = (1.0 - nu_d)*exp(tmp_dist.val[i])/nu_d;
-        dual_obj += log_one_plus_x(tmp) + log(nu_d) - tmp_dist.val[i];
-        distribution.val[i] = 1.0/(nu*(1.0 + tmp));
     }
 
     dual_obj /= (nu*eta);
     dual_obj += beta;
     
-    function_timer.stop();
     return dual_obj;
 }
 
 
 // Assume that dist has been set by previous call to fun
-DenseVector AbstractOptimizer::binary_gradient()
+void AbstractOptimizer::binary_gradient(double *grad)
 {
 
-    gradient_timer.start();
-    DenseVector grad_w;
-
-    // since the booster stores U transpose do normal dot and not
-    // transpose dot
-    if(transposed)
-        dot(U, distribution, grad_w);
-    else
-        transpose_dot(U, distribution, grad_w);
+    PROFILE_SCOPE(Profiler::solver_gradient);
+    num_gradient_evaluations += 1;
 
-    edge = max(grad_w);
-    // Adjust the gradient
-    scale(grad_w, -1.0);
-
-    DenseVector grad(num_weak_learners + 1);
-
-    // copy grad_w
-    for(size_t i = 0; i < num_weak_learners; i++)
-        grad.val[i] = grad_w.val[i];
+    // grad_w = -U'd
+    negative_edges(grad);
 
     // grad w.r.t beta
-    grad.val[num_weak_learners] = 1.0 - sum(distribution);
+    if(active_evaluation)
+    {
+        double mass = capped_multiplicity/nu;
+        for(size_t r = 0; r < active_examples.size(); r++)
+        {
+            mass += distribution.val[active_examples[r]];
+        }
+        grad[num_weak_learners] = 1.0 - mass;
+    }
+    else
+    {
+        grad[num_weak_learners] = 1.0 - sum(distribution);
+    }
 
     // The lowest primal objective we have seen so far
     min_primal = std::min(min_primal, primal());
@@ -469,8 +1151,25 @@ DenseVector AbstractOptimizer::binary_gradient()
     // duality gap w.r.t last known function value
     gap = min_primal + dual_obj;
 
-    gradient_timer.stop();
-    return grad;
+    return;
+}
+
+
+size_t AbstractOptimizer::get_num_iterations() const
+{
+    return num_iterations;
+}
+
+
+size_t AbstractOptimizer::get_num_function_evaluations() const
+{
+    return num_function_evaluations;
+}
+
+
+size_t AbstractOptimizer::get_num_gradient_evaluations() const
+{
+    return num_gradient_evaluations;
 }
 
 
@@ -484,14 +1183,19 @@ void AbstractOptimizer::report_statistics()
     // W.dim = 0;
     // std::cout << "X: " << x << std::endl;
     // std::cout << "dist: " << dist << std::endl;
-    std::cout << "Time spent in " <<  function_timer.num_calls
-              << " function evaluations: "
-              << function_timer.total_cpu << " seconds" << std::endl;
-    std::cout << "Time spent in " << gradient_timer.num_calls
-              << " gradient evaluations: "
-              << gradient_timer.total_cpu << " seconds" << std::endl;
-    function_timer.reset();
-    gradient_timer.reset();
+    if(num_active_evaluations > 0)
+    {
+        std::cout << "Function evaluations on the active examples only: "
+                  << num_active_evaluations << " (last screening kept "
+                  << (screening_valid? active_examples.size() : dim) << " of "
+                  << dim << " examples)" << std::endl;
+        num_active_evaluations = 0;
+    }
+    if(retire_after > 0)
+    {
+        std::cout << "Weak learners in the working set: " << num_weak_learners
+                  << " (" << retired_ids.size() << " in cold storage)" << std::endl;
+    }
     return;
 }
 
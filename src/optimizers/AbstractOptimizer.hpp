@@ -7,7 +7,9 @@
 #include "math/dense_vector.hpp"
 #include "math/sparse_vector.hpp"
 
-#include "Timer.hpp"
+#include "ColumnStore.hpp"
+
+#include <boost/shared_ptr.hpp>
 
 #include <vector>
 
@@ -25,6 +27,8 @@ namespace Optimizer
   const double kkt_gap_tol = 1e-3; // KKT gap violation tolerance
   const double pgnorm_tol = 1e-3;  // Max norm of projected gradient 
   const double wt_sum_tol = 1e-3;  // How much tolerance for the sum of wt - 1 
+  const double screening_slack = 20.0; // Room left for the margins to move, in units of eta*margin
+  const double dead_weight = 1e-3; // Weights moving eta*margin by less are dead, for the working set
 }
 
 
@@ -37,22 +41,126 @@ private:
   /// ERLPBoost function value and gradient
   double erlp_function();
   
-  DenseVector erlp_gradient();
+  void erlp_gradient(double *grad);
 
   /// Binary ERLPBoost function value and gradient
   double binary_function();
   
-  DenseVector binary_gradient();
+  void binary_gradient(double *grad);
   
   /// duality gap
   double gap;
+
+  /// Examples whose distribution is pinned (d_i = 0 up to machine
+  /// precision, or d_i = 1/nu for binary ERLPBoost) are screened out of
+  /// the function and gradient passes, see screen_examples()
+  bool screening_valid;
+
+  /// The last function evaluation only went over the active examples
+  bool active_evaluation;
+
+  std::vector<size_t> active_examples;
+
+  /// Margins (then exponents) of the active examples
+  std::vector<double> active_values;
+
+  /// w at the last full evaluation, the margins moved by at most
+  /// max_abs_u*|w - reference_w|_1 since
+  std::vector<double> reference_w;
+
+  /// Largest |U_ij|
+  double max_abs_u;
+
+  /// The examples screened at d_i = 0 (smallest reference margin) and,
+  /// for binary ERLPBoost, at d_i = 1/nu (largest reference margin, and
+  /// the column sums of U over them, weighted by the multiplicities)
+  size_t num_zero_examples, num_capped_examples;
+  double zero_multiplicity, capped_multiplicity;
+  double zero_min_margin, capped_max_margin;
+  std::vector<double> capped_column_sums;
+
+  /// ERLPBoost: the example with the smallest m_i + psi_i at the reference
+  size_t reference_min_example;
+  double reference_min_margin;
+
+  /// Function evaluations on the active examples only, since the last
+  /// report_statistics
+  size_t num_active_evaluations;
+
+  /// Picks the examples to screen out, from the margins U w of a full
+  /// evaluation at x
+  void screen_examples(const DenseVector& margins);
+
+  /// Bound on the change of the margins since the reference
+  double margin_drift() const;
+
+  /// active_values = margins of the active examples
+  void compute_active_margins();
+
+  /// Margins U w of the last full evaluation, allocated once
+  DenseVector full_margins;
+
+  /// full_margins = U w at x
+  void compute_full_margins();
+
+  /// U'd, for an evaluation on the active examples
+  void active_edges(double *edges) const;
+
+  /// edges = -U'd, and edge = max(U'd)
+  void negative_edges(double *edges);
+
+  /// primal() regularizer, for an evaluation on the active examples
+  double active_entropy() const;
+
+  /// Working set: weak learners at (nearly, see Optimizer::dead_weight)
+  /// zero weight for retire_after consecutive solves go to cold storage
+  /// (0 keeps all of them), whose
+  /// edges are checked every verify_interval calls to update_working_set
+  size_t retire_after, verify_interval;
+  size_t num_updates_since_verify;
+
+  /// Number of consecutive solves at nearly zero weight, of each column of U
+  std::vector<size_t> dead_solves;
+
+  /// The retired columns (push order) and their keys in cold_storage
+  std::vector<size_t> retired_ids;
+  std::vector<long> retired_keys;
+  boost::shared_ptr<ColumnStore> cold_storage;
+
+  /// Moves the columns of U (ascending positions) to cold storage, the
+  /// remaining weights are scaled back to the simplex
+  void retire_columns(const std::vector<size_t>& positions);
+
+  /// Appends the retired column retired_ids[k] to U, with a zero weight
+  void restore_retired(const size_t k);
     
 protected:
   /// Columns of U
   size_t num_weak_learners;
+
+  /// Position of each column of U in the push order (the weak learner
+  /// indices of the booster), the retired ones are not in U
+  std::vector<size_t> column_ids;
+
+  /// Columns retired so far (the positions in U changed)
+  size_t num_retired_columns;
   
   /// Rows of U
   size_t dim;        
+
+  /// Number of identical examples each row stands for (see
+  /// deduplicate_examples), 1 unless set_example_multiplicities was called.
+  /// The reference distribution is multiplicities/num_examples and the
+  /// cap of d_i is multiplicities_i/nu
+  DenseVector multiplicities;
+
+  /// Sum of the multiplicities
+  double num_examples;
+
+  /// true once set_example_multiplicities was called, otherwise the
+  /// functions keep their unweighted arithmetic (-ffast-math rounds the
+  /// weighted expressions differently, even with all multiplicities at 1)
+  bool weighted_examples;
   
   /// Weak learners
   std::vector<DenseVector> U; 
@@ -68,6 +176,10 @@ protected:
   
   /// epsilon tolerance of outer boosting loop
   double epsilon;
+
+  /// solve() stops when the duality gap is below this tolerance
+  /// (0.5*epsilon unless set by the booster, see set_gap_tolerance)
+  double gap_tolerance;
   
   /// Are we solving binary boost problem?
   bool binary;
@@ -81,8 +193,11 @@ protected:
   /// projected gradient norm for psi < pgnorm_tol
   bool pgnorm_met(const DenseVector& gradk);
 
-  /// Keep track of time spent in function and gradient evaluation
-  Timer function_timer, gradient_timer;
+  /// Number of iterations done by the last call to solve()
+  size_t num_iterations;
+
+  /// Function and gradient evaluations since the optimizer was created
+  size_t num_function_evaluations, num_gradient_evaluations;
 
   void report_statistics();
   
@@ -113,8 +228,29 @@ public:
   virtual ~AbstractOptimizer();
   
   void set_distribution(const DenseVector& _distribution);
+
+  /// Row i of U stands for multiplicities[i] identical examples
+  virtual void set_example_multiplicities(const DenseVector& multiplicities);
   
   void push_back(const SparseVector& u);
+
+  /// Weak learners whose weight stayed nearly 0 for retire_after
+  /// consecutive solves leave U (to a temporary file), the retired ones are checked
+  /// every verify_interval calls to update_working_set()
+  void set_working_set(const size_t retire_after, const size_t verify_interval);
+
+  /// To call after each solve: retires the long dead columns, and brings
+  /// back the retired ones whose edge exceeds the max edge when checked
+  /// @return true if columns came back (then the solve must be redone)
+  bool update_working_set();
+
+  /// Brings back the column pushed at position id, if it was retired
+  /// (when the oracle returns its weak learner again)
+  /// @return true if it came back
+  bool restore_column(const size_t id);
+
+  /// Weights of all the columns pushed, in push order (0 if retired)
+  DenseVector get_weights() const;
   
   /// ERLPBoost function
   double function();
@@ -122,15 +258,31 @@ public:
   /// ERLPBoost gradient
   DenseVector gradient();
 
+  /// Writes the ERLPBoost gradient in grad (x.dim entries), without
+  /// allocating
+  void gradient(double *grad);
+
   /// ERLPBoost primal function
   double primal();
   
   bool converged(const DenseVector& gradk);
 
   bool duality_gap_met();
+
+  /// Allows inexact solves when the booster is far from converged,
+  /// tolerances below 0.5*epsilon are raised to 0.5*epsilon
+  void set_gap_tolerance(const double tolerance);
+
+  double get_gap_tolerance() const;
   
   /// Derived classes will implement this method
   virtual int solve() = 0;
+
+  size_t get_num_iterations() const;
+
+  size_t get_num_function_evaluations() const;
+
+  size_t get_num_gradient_evaluations() const;
   
 }; 
 
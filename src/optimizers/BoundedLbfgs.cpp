@@ -0,0 +1,401 @@
+#include "BoundedLbfgs.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+
+/// @return a'b
+double parallel_dot(const double *a, const double *b, const long n)
+{
+    double result = 0.0;
+#pragma omp parallel for simd reduction(+:result) schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        result += a[i]*b[i];
+    }
+    return result;
+}
+
+
+/// y += a*x
+void parallel_axpy(const double a, const double *x, double *y, const long n)
+{
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        y[i] += a*x[i];
+    }
+    return;
+}
+
+
+/// Variables at a bound, with the gradient pushing outside
+inline bool is_fixed(const double x, const double g, const double lower, const double upper)
+{
+    return (x <= lower and g > 0.0) or (x >= upper and g < 0.0);
+}
+
+
+/// @return the infinity norm of the gradient projected on the bounds
+double projected_gradient_norm(const double *x, const double *g,
+                               const double *lower, const double *upper,
+                               const long n)
+{
+    double norm = 0.0;
+#pragma omp parallel for reduction(max:norm) schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        double projected_g = g[i];
+        if(projected_g < 0.0)
+        {
+            projected_g = std::max(x[i] - upper[i], projected_g);
+        }
+        else
+        {
+            projected_g = std::min(x[i] - lower[i], projected_g);
+        }
+        norm = std::max(norm, std::abs(projected_g));
+    }
+    return norm;
+}
+
+} // end of anonymous namespace
+
+
+BoundedLbfgsObjective::~BoundedLbfgsObjective()
+{
+    // nothing to do here
+    return;
+}
+
+
+BoundedLbfgs::BoundedLbfgs(const size_t memory_)
+    : memory(memory_), dim(0),
+      s(memory_), y(memory_), rho(memory_, 0.0), alpha(memory_, 0.0),
+      num_pairs(0), newest(memory_ - 1), gamma(1.0),
+      num_iterations(0)
+{
+    assert(memory > 0);
+    return;
+}
+
+
+BoundedLbfgs::~BoundedLbfgs()
+{
+    // nothing to do here
+    return;
+}
+
+
+void BoundedLbfgs::reset()
+{
+    num_pairs = 0;
+    newest = memory - 1;
+    gamma = 1.0;
+    return;
+}
+
+
+void BoundedLbfgs::reserve_capacity(const size_t capacity)
+{
+    if(gradient.capacity() >= capacity)
+    {
+        return;
+    }
+
+    for(size_t k = 0; k < memory; k++)
+    {
+        s[k].reserve(capacity);
+        y[k].reserve(capacity);
+    }
+    gradient.reserve(capacity);
+    direction.reserve(capacity);
+    previous_x.reserve(capacity);
+    previous_gradient.reserve(capacity);
+    return;
+}
+
+
+void BoundedLbfgs::reserve(const size_t num_variables, const size_t headroom)
+{
+    if(num_variables != dim)
+    {
+        reset();
+    }
+    dim = num_variables;
+
+    if(gradient.capacity() < dim)
+    {
+        reserve_capacity(dim + headroom);
+    }
+
+    for(size_t k = 0; k < memory; k++)
+    {
+        s[k].resize(dim);
+        y[k].resize(dim);
+    }
+    gradient.resize(dim);
+    direction.resize(dim);
+    previous_x.resize(dim);
+    previous_gradient.resize(dim);
+    return;
+}
+
+
+void BoundedLbfgs::insert_zero_coordinates(const size_t position, const size_t count, const size_t headroom)
+{
+    assert(position <= dim);
+
+    if(gradient.capacity() < dim + count)
+    {
+        reserve_capacity(dim + count + headroom);
+    }
+
+    for(size_t k = 0; k < memory; k++)
+    {
+        s[k].insert(s[k].begin() + position, count, 0.0);
+        y[k].insert(y[k].begin() + position, count, 0.0);
+    }
+
+    dim += count;
+    gradient.resize(dim);
+    direction.resize(dim);
+    previous_x.resize(dim);
+    previous_gradient.resize(dim);
+    return;
+}
+
+
+void BoundedLbfgs::compute_direction(const DenseVector& x,
+                                     const std::vector<double>& lower,
+                                     const std::vector<double>& upper)
+{
+    const long n = dim;
+    const double *g = &gradient[0];
+    double *d = &direction[0];
+
+    // q = g on the free variables
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        d[i] = is_fixed(x.val[i], g[i], lower[i], upper[i])? 0.0 : g[i];
+    }
+
+    // two-loop recursion, from the newest pair to the oldest and back
+    size_t k = newest;
+    for(size_t j = 0; j < num_pairs; j++)
+    {
+        alpha[k] = rho[k]*parallel_dot(&s[k][0], d, n);
+        parallel_axpy(-alpha[k], &y[k][0], d, n);
+        k = (k + memory - 1) % memory;
+    }
+
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        d[i] *= gamma;
+    }
+
+    for(size_t j = 0; j < num_pairs; j++)
+    {
+        k = (k + 1) % memory;
+        const double beta = rho[k]*parallel_dot(&y[k][0], d, n);
+        parallel_axpy(alpha[k] - beta, &s[k][0], d, n);
+    }
+
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        d[i] = is_fixed(x.val[i], g[i], lower[i], upper[i])? 0.0 : -d[i];
+    }
+    return;
+}
+
+
+void BoundedLbfgs::update_pairs(const DenseVector& x)
+{
+    const long n = dim;
+    const double *g = &gradient[0];
+    const double *x_old = &previous_x[0];
+    const double *g_old = &previous_gradient[0];
+
+    double sy = 0.0, yy = 0.0;
+#pragma omp parallel for simd reduction(+:sy,yy) schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        const double s_i = x.val[i] - x_old[i];
+        const double y_i = g[i] - g_old[i];
+        sy += s_i*y_i;
+        yy += y_i*y_i;
+    }
+
+    // keep the approximation positive definite
+    if(sy <= std::numeric_limits<double>::epsilon()*yy)
+    {
+        return;
+    }
+
+    const size_t k = (newest + 1) % memory;
+    double *s_k = &s[k][0];
+    double *y_k = &y[k][0];
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        s_k[i] = x.val[i] - x_old[i];
+        y_k[i] = g[i] - g_old[i];
+    }
+
+    rho[k] = 1.0/sy;
+    gamma = sy/yy;
+    newest = k;
+    num_pairs = std::min(num_pairs + 1, memory);
+    return;
+}
+
+
+int BoundedLbfgs::minimize(BoundedLbfgsObjective& objective,
+                           DenseVector& x,
+                           const std::vector<double>& lower,
+                           const std::vector<double>& upper,
+                           const double epsg,
+                           const double epsf,
+                           const double epsx,
+                           const size_t max_iterations)
+{
+    assert(lower.size() >= x.dim and upper.size() >= x.dim);
+
+    reserve(x.dim, 0);
+    num_iterations = 0;
+
+    const long n = dim;
+    const double *l = &lower[0];
+    const double *u = &upper[0];
+    double *g = &gradient[0];
+    double *d = &direction[0];
+    double *x_old = &previous_x[0];
+    double *g_old = &previous_gradient[0];
+
+#pragma omp parallel for simd schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+    for(long i = 0; i < n; i++)
+    {
+        x.val[i] = std::min(std::max(x.val[i], l[i]), u[i]);
+    }
+
+    double f = objective.function_and_gradient(x, g);
+    if(projected_gradient_norm(x.val, g, l, u, n) <= epsg)
+    {
+        return 4;
+    }
+
+    while(true)
+    {
+        compute_direction(x, lower, upper);
+
+        if(parallel_dot(g, d, n) >= 0.0)
+        {
+            if(num_pairs == 0)
+            {
+                return -2;
+            }
+
+            // the pairs of a previous problem may not give a descent direction
+            reset();
+            continue;
+        }
+
+        std::copy(x.val, x.val + n, x_old);
+        std::copy(g, g + n, g_old);
+        const double f_old = f;
+
+        // steepest descent starts with a step of unit length
+        double step = 1.0;
+        if(num_pairs == 0)
+        {
+            step = std::min(1.0, 1.0/std::sqrt(parallel_dot(d, d, n)));
+        }
+
+        // backtracking along the projection arc x(step) = P(x_old + step*d)
+        bool sufficient_decrease = false;
+        for(size_t backtrack = 0; backtrack < BoundedLBFGS::max_backtracks; backtrack++)
+        {
+            double decrease = 0.0;
+#pragma omp parallel for simd reduction(+:decrease) schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+            for(long i = 0; i < n; i++)
+            {
+                const double x_i = std::min(std::max(x_old[i] + step*d[i], l[i]), u[i]);
+                x.val[i] = x_i;
+                decrease += g_old[i]*(x_i - x_old[i]);
+            }
+
+            f = objective.function_and_gradient(x, g);
+            if(f <= f_old + BoundedLBFGS::armijo*decrease)
+            {
+                sufficient_decrease = true;
+                break;
+            }
+            step *= 0.5;
+        }
+
+        if(not sufficient_decrease)
+        {
+            std::copy(x_old, x_old + n, x.val);
+            std::copy(g_old, g_old + n, g);
+            f = f_old;
+
+            if(num_pairs == 0)
+            {
+                return -2;
+            }
+
+            // retry from the steepest descent
+            reset();
+            continue;
+        }
+
+        num_iterations++;
+        update_pairs(x);
+
+        if(projected_gradient_norm(x.val, g, l, u, n) <= epsg)
+        {
+            return 4;
+        }
+
+        double step_norm = 0.0;
+#pragma omp parallel for simd reduction(+:step_norm) schedule(static) if(n > long(BoundedLBFGS::parallel_threshold))
+        for(long i = 0; i < n; i++)
+        {
+            step_norm += (x.val[i] - x_old[i])*(x.val[i] - x_old[i]);
+        }
+        if(std::sqrt(step_norm) <= epsx)
+        {
+            return 2;
+        }
+
+        if(f_old - f <= epsf*std::max(std::max(std::abs(f_old), std::abs(f)), 1.0))
+        {
+            return 1;
+        }
+
+        if(max_iterations > 0 and num_iterations >= max_iterations)
+        {
+            return 5;
+        }
+    }
+
+    return -2;
+}
+
+
+size_t BoundedLbfgs::get_num_iterations() const
+{
+    return num_iterations;
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,116 @@
+#ifndef _OPTIMIZER_BOUNDED_LBFGS_HPP_
+#define _OPTIMIZER_BOUNDED_LBFGS_HPP_
+
+#include "math/dense_vector.hpp"
+
+#include <vector>
+
+namespace totally_corrective_boosting
+{
+
+namespace BoundedLBFGS
+{
+const double armijo = 1e-4; // Sufficient decrease of the line search
+const size_t max_backtracks = 20; // Step halvings before the line search fails
+const size_t parallel_threshold = 8192; // Smaller vectors are processed by a single thread
+}
+
+
+/// Function minimized by BoundedLbfgs
+class BoundedLbfgsObjective
+{
+public:
+    virtual ~BoundedLbfgsObjective();
+
+    /// @return the value at x, the gradient is written in gradient[0, x.dim)
+    virtual double function_and_gradient(const DenseVector& x, double *gradient) = 0;
+};
+
+
+/// Limited memory BFGS with bound constraints lower <= x <= upper.
+///
+/// Variables at a bound with the gradient pushing outside are fixed, the
+/// two-loop recursion gives the direction on the others, and the step is
+/// searched (by backtracking) along the projection of the direction on the
+/// bounds. The correction pairs and all the workspace are kept between
+/// calls to minimize(), so that successive problems can warm start and no
+/// allocation happens once the capacity is reached. The vector operations
+/// are split among the OpenMP threads on large problems.
+class BoundedLbfgs
+{
+
+protected:
+
+    /// Maximum number of correction pairs
+    size_t memory;
+
+    /// Number of variables of the stored pairs and workspace
+    size_t dim;
+
+    /// Correction pairs s = x_{k+1} - x_k and y = g_{k+1} - g_k
+    /// (circular buffer, the newest is at index newest)
+    std::vector< std::vector<double> > s, y;
+    std::vector<double> rho, alpha;
+    size_t num_pairs, newest;
+
+    /// Scaling of the initial inverse Hessian, s'y/y'y of the newest pair
+    double gamma;
+
+    /// Gradient, direction, and previous iterate and gradient
+    std::vector<double> gradient, direction, previous_x, previous_gradient;
+
+    /// Iterations of the last call to minimize()
+    size_t num_iterations;
+
+    /// Fills direction with minus the inverse Hessian approximation
+    /// times the gradient, on the free variables
+    void compute_direction(const DenseVector& x,
+                           const std::vector<double>& lower,
+                           const std::vector<double>& upper);
+
+    /// Keeps the pair of the last step, unless its curvature is not positive
+    void update_pairs(const DenseVector& x);
+
+    /// Grows all the vectors to hold capacity variables, without changing dim
+    void reserve_capacity(const size_t capacity);
+
+public:
+
+    BoundedLbfgs(const size_t memory);
+    ~BoundedLbfgs();
+
+    /// Make room for num_variables (with headroom if the workspace grows),
+    /// the stored pairs are forgotten if num_variables differs from their size
+    void reserve(const size_t num_variables, const size_t headroom);
+
+    /// Insert count variables before position (0-based), with zero
+    /// entries in the stored pairs, which still describe the other variables
+    void insert_zero_coordinates(const size_t position, const size_t count, const size_t headroom);
+
+    /// Forget the stored pairs
+    void reset();
+
+    /// Minimizes objective from x (projected on the bounds), in place.
+    /// Stops when the infinity norm of the projected gradient is below
+    /// epsg, the relative decrease below epsf, the step below epsx,
+    /// or after max_iterations (if not 0). Starts from the stored pairs
+    /// if they describe a problem of the same size.
+    ///
+    /// @return the same codes as the original L-BFGS-B:
+    /// -2 the line search failed, 1 relative decrease <= epsf,
+    /// 2 step <= epsx, 4 projected gradient <= epsg, 5 max_iterations reached
+    int minimize(BoundedLbfgsObjective& objective,
+                 DenseVector& x,
+                 const std::vector<double>& lower,
+                 const std::vector<double>& upper,
+                 const double epsg,
+                 const double epsf,
+                 const double epsx,
+                 const size_t max_iterations);
+
+    size_t get_num_iterations() const;
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // _OPTIMIZER_BOUNDED_LBFGS_HPP_
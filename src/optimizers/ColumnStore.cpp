@@ -0,0 +1,50 @@
+#include "ColumnStore.hpp"
+
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+ColumnStore::ColumnStore()
+    : file(std::tmpfile()),
+      end_offset(0)
+{
+    if(file == NULL)
+    {
+        throw std::runtime_error("Cannot create the temporary file of the retired weak learners");
+    }
+    return;
+}
+
+
+ColumnStore::~ColumnStore()
+{
+    std::fclose(file);
+    return;
+}
+
+
+long ColumnStore::write(const DenseVector &column)
+{
+    const long key = end_offset;
+    if(std::fseek(file, key, SEEK_SET) != 0
+       or std::fwrite(column.val, sizeof(double), column.dim, file) != column.dim)
+    {
+        throw std::runtime_error("Cannot write a retired weak learner to the temporary file");
+    }
+    end_offset += column.dim*sizeof(double);
+    return key;
+}
+
+
+void ColumnStore::read(const long key, DenseVector &column)
+{
+    if(std::fseek(file, key, SEEK_SET) != 0
+       or std::fread(column.val, sizeof(double), column.dim, file) != column.dim)
+    {
+        throw std::runtime_error("Cannot read a retired weak learner from the temporary file");
+    }
+    return;
+}
+
+} // end of namespace totally_corrective_boosting
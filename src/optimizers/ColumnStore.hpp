@@ -0,0 +1,49 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_COLUMNSTORE_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_COLUMNSTORE_HPP
+
+#include "math/dense_vector.hpp"
+
+#include <cstdio>
+
+namespace totally_corrective_boosting
+{
+
+/// Cold storage of dense columns, for the weak learners retired from the
+/// working set of the optimizer (see AbstractOptimizer::set_working_set).
+///
+/// The columns are appended to an anonymous temporary file, removed by
+/// the system when the store is destroyed. A column read back stays in
+/// the file (it is written again if retired again).
+class ColumnStore
+{
+
+protected:
+
+    std::FILE *file;
+
+    /// Where the next column goes
+    long end_offset;
+
+private:
+
+    // not copyable
+    ColumnStore(const ColumnStore &);
+    ColumnStore &operator=(const ColumnStore &);
+
+public:
+
+    ColumnStore();
+
+    ~ColumnStore();
+
+    /// @return the key of the column, for read()
+    long write(const DenseVector &column);
+
+    /// column must have the dimension of the column written at key
+    void read(const long key, DenseVector &column);
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_COLUMNSTORE_HPP
@@ -1,8 +1,7 @@
-
 #ifndef _OPTIMIZER_CD_HPP_
 #define _OPTIMIZER_CD_HPP_
 
-#include "AbstractOptimizer.hpp"
+#include "FrankWolfeOptimizer.hpp"
 
 namespace totally_corrective_boosting
 {
@@ -10,20 +9,17 @@ namespace totally_corrective_boosting
 
 namespace CD{
   const size_t max_iter = 50000;
-  const size_t ls_max_iter = 20;
+  const double gap_tolerance_factor = 0.1; // CD stops at a tighter gap than the other solvers
 }
 
 /// Implement coordinate descent. Basically this is nothing but the
-/// corrective algorithm which is run in a loop.
-class CoordinateDescentOptimizer : public AbstractOptimizer {
+/// corrective algorithm which is run in a loop: w moves towards the weak
+/// learner of largest edge, w <- (1 - eta_t) w + eta_t e_j.
+/// This is Frank-Wolfe without the away steps, so it shares the margins
+/// U w, the closed form distribution and the O(N) line search of
+/// FrankWolfeOptimizer.
+class CoordinateDescentOptimizer : public FrankWolfeOptimizer {
   
-private:
-  double proj_simplex(DenseVector& distribution, const double& exp_max);
-
-  double line_search(DenseVector& W, 
-                     const DenseVector& grad_w, 
-                     const size_t& index);
-    
 public:
   
   CoordinateDescentOptimizer(const size_t& dim,
@@ -0,0 +1,237 @@
+
+#include "FistaOptimizer.hpp"
+
+#include "math/vector_operations.hpp"
+
+#include <limits>
+#include <cmath>
+#include <iostream>
+
+
+namespace totally_corrective_boosting
+{
+
+
+FistaOptimizer::FistaOptimizer(const size_t& dim,
+                               const bool& transposed,
+                               const double& eta,
+                               const double& nu,
+                               const double& epsilon,
+                               const bool& binary):
+    ProjectedGradientOptimizer(dim, transposed, eta, nu, epsilon, binary),
+    lipschitz(Fista::initial_lipschitz),
+    min_feasible_primal(std::numeric_limits<double>::max())
+{
+    // nothing to do here
+}
+
+
+FistaOptimizer::~FistaOptimizer()
+{
+    // nothing to do here
+}
+
+
+void FistaOptimizer::set_example_multiplicities(const DenseVector& multiplicities_)
+{
+    ProjectedGradientOptimizer::set_example_multiplicities(multiplicities_);
+    capped_softmax.set_multiplicities(multiplicities);
+    return;
+}
+
+
+bool FistaOptimizer::binary_gap_met()
+{
+    DenseVector W;
+    W.val = x.val;
+    W.dim = num_weak_learners;
+
+    margins.clear();
+
+    // since the booster stores U transpose do transpose dot
+    if(transposed)
+    {
+        transpose_dot(U, W, margins);
+    }
+    else
+    {
+        dot(U, W, margins);
+    }
+
+    // This is not a memory leak! (because W.val is only pointing to x.val)
+    W.val = NULL;
+    W.dim = 0;
+
+    feasible_distribution.resize(dim);
+    double beta = x.val[num_weak_learners];
+    const double objective = capped_softmax.evaluate_binary(margins, eta, nu, feasible_distribution, beta);
+
+    DenseVector edges;
+    if(transposed)
+    {
+        dot(U, feasible_distribution, edges);
+    }
+    else
+    {
+        transpose_dot(U, feasible_distribution, edges);
+    }
+
+    const double feasible_primal = max(edges) + binary_relative_entropy(feasible_distribution, multiplicities, nu)/eta;
+    min_feasible_primal = std::min(min_feasible_primal, feasible_primal);
+
+    // the optimal beta also lowers the dual objective of x
+    if(min_feasible_primal + objective >= gap_tolerance)
+    {
+        return false;
+    }
+
+    x.val[num_weak_learners] = beta;
+    copy(feasible_distribution, distribution);
+    dual_obj = objective;
+    edge = max(edges);
+    // the primal values seen at the y_{k} are not reported
+    min_primal = min_feasible_primal;
+    return true;
+}
+
+
+void FistaOptimizer::project(DenseVector& z)
+{
+    if(binary)
+    {
+        project_binary(z);
+    }
+    else
+    {
+        project_erlp(z);
+    }
+    return;
+}
+
+
+int FistaOptimizer::solve()
+{
+    // the iterates x_{k} must be feasible, the extrapolated points
+    // y_{k} may not be
+    project(x);
+
+    // k-th iterate
+    DenseVector xk(x);
+
+    // extrapolated point and its gradient
+    DenseVector y(x);
+    DenseVector grady;
+
+    // Intermediate iterate
+    DenseVector xplus(x.dim);
+
+    double t = 1.0;
+
+    min_feasible_primal = std::numeric_limits<double>::max();
+
+    // after a restart y_{k} = x_{k}, whose function value (and the
+    // distribution) are those of the last accepted step
+    bool restarted = false;
+    double objy = 0.0;
+
+    for(size_t i = 1; i <= Fista::max_iter; i++)
+    {
+        num_iterations = i;
+
+        // Step 1: f and its gradient at y_{k}
+        if(not restarted)
+        {
+            copy(y, x);
+            objy = function();
+        }
+        grady = gradient();
+
+        // Step 2: Backtracking on the Lipschitz constant
+        // x_{+} = P(y_{k} - g_{k}/L) until
+        // f(x_{+}) <= f(y_{k}) + <g_{k}, x_{+} - y_{k}> + L/2 ||x_{+} - y_{k}||^2
+        lipschitz *= Fista::lipschitz_decrease;
+        bool accepted = false;
+        double objplus = 0.0;
+        for(size_t backtrack = 0; backtrack < Fista::max_backtracks; backtrack++)
+        {
+            axpy(-1.0/lipschitz, grady, y, xplus);
+            project(xplus);
+            copy(xplus, x);
+
+            objplus = function();
+
+            double dtg = 0.0;
+            double dtd = 0.0;
+            for(size_t j = 0; j < x.dim; j++)
+            {
+                const double dj = xplus.val[j] - y.val[j];
+                dtg += dj*grady.val[j];
+                dtd += dj*dj;
+            }
+
+            // the slack absorbs the rounding errors once x_{+} is close to y_{k}
+            const double slack = std::numeric_limits<double>::epsilon()*std::fabs(objy);
+            if(objplus <= objy + dtg + 0.5*lipschitz*dtd + slack)
+            {
+                accepted = true;
+                break;
+            }
+            lipschitz *= Fista::lipschitz_increase;
+        }
+
+        if(not accepted)
+        {
+            std::cout << "Failure in FISTA optimizer " << std::endl;
+            copy(xk, x);
+            function();
+            return 1;
+        }
+
+        // Step 3: Detect if we have converged
+        // x_{+} is feasible, so dual_obj (evaluated at x_{+}) and the primal
+        // values seen at the y_{k} bound the gap, the same test as
+        // duality_gap_met() which would use the (infeasible) y_{k}.
+        // In the binary case the distribution at the y_{k} does not sum
+        // to 1, their primal values are not bounds
+        const bool converged = binary? binary_gap_met() : (min_primal + dual_obj < gap_tolerance);
+        if(converged)
+        {
+            report_statistics();
+            return 0;
+        }
+
+        // Step 4: Restart the momentum when the gradient mapping
+        // y_{k} - x_{+} makes an acute angle with the step x_{+} - x_{k}
+        double restart = 0.0;
+        for(size_t j = 0; j < x.dim; j++)
+        {
+            restart += (y.val[j] - xplus.val[j])*(xplus.val[j] - xk.val[j]);
+        }
+
+        restarted = (restart > 0.0);
+        if(restarted)
+        {
+            t = 1.0;
+            copy(xplus, y);
+            objy = objplus;
+        }
+        else
+        {
+            // y_{k+1} = x_{+} + (t_{k} - 1)/t_{k+1} (x_{+} - x_{k})
+            const double tnext = 0.5*(1.0 + std::sqrt(1.0 + 4.0*t*t));
+            const double momentum = (t - 1.0)/tnext;
+            for(size_t j = 0; j < x.dim; j++)
+            {
+                y.val[j] = xplus.val[j] + momentum*(xplus.val[j] - xk.val[j]);
+            }
+            t = tnext;
+        }
+
+        copy(xplus, xk);
+    } // end of "for each iteration"
+
+    std::cout << "Failure in FISTA optimizer " << std::endl;
+    return 1;
+}
+
+} // end of namespace totally_corrective_boosting
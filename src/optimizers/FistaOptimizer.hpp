@@ -0,0 +1,74 @@
+
+#ifndef _OPTIMIZER_FISTA_HPP_
+#define _OPTIMIZER_FISTA_HPP_
+
+#include "ProjectedGradientOptimizer.hpp"
+
+#include "math/capped_softmax.hpp"
+
+
+namespace totally_corrective_boosting
+{
+
+
+namespace Fista{
+const double initial_lipschitz = 1.0; // Estimate used by the first solve
+const double lipschitz_increase = 2.0; // Backtracking factor
+const double lipschitz_decrease = 0.9; // Lets the estimate shrink at each iteration
+const size_t max_backtracks = 60;
+const size_t max_iter = 100000;
+}
+
+
+/// Implements the accelerated projected gradient (FISTA) with
+/// backtracking on the Lipschitz constant and gradient based restart
+///
+/// A. Beck and M. Teboulle
+/// A Fast Iterative Shrinkage-Thresholding Algorithm for Linear Inverse Problems
+/// SIAM J. Imaging Sci., Vol. 2, No. 1, pp. 183-202
+///
+/// B. O'Donoghue and E. Candes
+/// Adaptive Restart for Accelerated Gradient Schemes
+/// Found. Comput. Math., Vol. 15, No. 3, pp. 715-732
+class FistaOptimizer : public ProjectedGradientOptimizer {
+
+protected:
+
+    /// Lipschitz estimate, kept between the solves of the totally
+    /// corrective steps (which only add columns)
+    double lipschitz;
+
+    /// Projects z on the feasible set, in place
+    void project(DenseVector& z);
+
+    /// Binary ERLPBoost: the distribution at x only sums to 1 at the
+    /// optimal beta, the primal bounds of the gap are taken at the
+    /// distribution of the optimal beta for the margins U w of x
+    CappedSoftmax capped_softmax;
+    DenseVector margins, feasible_distribution;
+
+    /// Lowest of those primal values in the current solve
+    double min_feasible_primal;
+
+    /// Binary duality gap test at x, if it is met x gets the optimal
+    /// beta (and the distribution and dual_obj follow)
+    bool binary_gap_met();
+
+public:
+
+    FistaOptimizer(const size_t& dim,
+                   const bool& transposed,
+                   const double& eta,
+                   const double& nu,
+                   const double& epsilon,
+                   const bool& binary);
+    ~FistaOptimizer();
+
+    void set_example_multiplicities(const DenseVector& multiplicities);
+
+    int solve();
+};
+
+} // end of namespace totally_corrective_boosting
+
+# endif
@@ -0,0 +1,338 @@
+
+#include "FrankWolfeOptimizer.hpp"
+
+#include "math/vector_operations.hpp"
+#include "Profiler.hpp"
+
+#include <limits>
+#include <cmath>
+#include <iostream>
+
+
+namespace totally_corrective_boosting
+{
+
+
+FrankWolfeOptimizer::FrankWolfeOptimizer(const size_t& dim,
+                                         const bool& transposed,
+                                         const double& eta,
+                                         const double& nu,
+                                         const double& epsilon,
+                                         const bool& binary):
+    AbstractOptimizer(dim, transposed, eta, nu, epsilon, binary),
+    beta(0.0)
+{
+    // nothing to do here
+}
+
+
+FrankWolfeOptimizer::~FrankWolfeOptimizer()
+{
+    // nothing to do here
+}
+
+
+void FrankWolfeOptimizer::set_example_multiplicities(const DenseVector& multiplicities_)
+{
+    AbstractOptimizer::set_example_multiplicities(multiplicities_);
+    capped_softmax.set_multiplicities(multiplicities);
+    return;
+}
+
+
+void FrankWolfeOptimizer::compute_margins()
+{
+    DenseVector W;
+    W.val = x.val;
+    W.dim = num_weak_learners;
+
+    margins.clear();
+
+    // since the booster stores U transpose do transpose dot
+    if(transposed)
+    {
+        transpose_dot(U, W, margins);
+    }
+    else
+    {
+        dot(U, W, margins);
+    }
+
+    // This is not a memory leak! (because W.val is only pointing to x.val)
+    W.val = NULL;
+    W.dim = 0;
+    return;
+}
+
+
+double FrankWolfeOptimizer::evaluate(const DenseVector& m, const bool write_solution)
+{
+    PROFILE_SCOPE(Profiler::solver_function);
+    num_function_evaluations += 1;
+
+    double objective = 0.0;
+    if(binary)
+    {
+        objective = capped_softmax.evaluate_binary(m, eta, nu, distribution, beta);
+        if(write_solution)
+        {
+            x.val[num_weak_learners] = beta;
+        }
+    }
+    else
+    {
+        objective = capped_softmax.evaluate(m, eta, nu, distribution,
+                                            write_solution? x.val + num_weak_learners : NULL);
+    }
+
+    return objective;
+}
+
+
+double FrankWolfeOptimizer::curvature_weight(const size_t i) const
+{
+    const double d = distribution.val[i];
+    const double m = weighted_examples? multiplicities.val[i] : 1.0;
+    if(binary)
+    {
+        return d*(1.0 - nu*d/m);
+    }
+
+    // the capped examples do not move with the margins
+    return (d < m/nu)? d : 0.0;
+}
+
+
+double FrankWolfeOptimizer::start()
+{
+    compute_margins();
+    direction.resize(dim);
+    trial_margins.resize(dim);
+
+    if(binary)
+    {
+        beta = x.val[num_weak_learners];
+    }
+    return evaluate(margins);
+}
+
+
+void FrankWolfeOptimizer::compute_edges()
+{
+    PROFILE_SCOPE(Profiler::solver_gradient);
+    num_gradient_evaluations += 1;
+    edges.clear();
+
+    // since the booster stores U transpose do normal dot and not
+    // transpose dot
+    if(transposed)
+    {
+        dot(U, distribution, edges);
+    }
+    else
+    {
+        transpose_dot(U, distribution, edges);
+    }
+
+    edge = max(edges);
+    return;
+}
+
+
+bool FrankWolfeOptimizer::gap_met(const double objective, const double tolerance_factor)
+{
+    dual_obj = objective;
+    min_primal = std::min(min_primal, primal());
+    if(min_primal + dual_obj >= tolerance_factor*gap_tolerance)
+    {
+        return false;
+    }
+
+    // psi (or beta) of the current margins, so that x is a solution
+    dual_obj = evaluate(margins, true);
+    return true;
+}
+
+
+void FrankWolfeOptimizer::set_direction(const size_t j, const double sign)
+{
+    if(transposed)
+    {
+        const double *column = U[j].val;
+        for(size_t i = 0; i < dim; i++)
+        {
+            direction.val[i] = sign*(column[i] - margins.val[i]);
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < dim; i++)
+        {
+            direction.val[i] = sign*(U[i].val[j] - margins.val[i]);
+        }
+    }
+    return;
+}
+
+
+double FrankWolfeOptimizer::line_search(const double gamma_max, double& objective)
+{
+    // phi(gamma) = f(m + gamma*direction) is convex, with
+    // phi'(gamma) = -d'direction and (away from the caps)
+    // phi''(gamma) = eta*(sum h*direction^2 - (sum h*direction)^2/sum h)
+    double slope = 0.0, curvature = 0.0;
+    double mass = 0.0, weighted_slope = 0.0, weighted_square = 0.0;
+    for(size_t i = 0; i < dim; i++)
+    {
+        const double h = curvature_weight(i);
+        slope -= distribution.val[i]*direction.val[i];
+        mass += h;
+        weighted_slope += h*direction.val[i];
+        weighted_square += h*direction.val[i]*direction.val[i];
+    }
+    if(mass > 0.0)
+    {
+        curvature = eta*(weighted_square - weighted_slope*weighted_slope/mass);
+    }
+
+    const double initial_slope = slope;
+    if(initial_slope >= 0.0)
+    {
+        // no descent (rounding errors next to the optimum)
+        return 0.0;
+    }
+
+    // Newton steps, safeguarded by bisection once the minimum is bracketed
+    double lower = 0.0, upper = gamma_max;
+    bool upper_evaluated = false;
+    double gamma = 0.0;
+    for(size_t k = 0; k < FrankWolfe::line_search_max_iter; k++)
+    {
+        double next = (curvature > 0.0)? gamma - slope/curvature : upper;
+        if(next >= upper)
+        {
+            next = upper_evaluated? 0.5*(lower + upper) : upper;
+        }
+        if(next <= lower)
+        {
+            next = 0.5*(lower + upper);
+        }
+        gamma = next;
+
+        axpy(gamma, direction, margins, trial_margins);
+        objective = evaluate(trial_margins);
+
+        slope = 0.0;
+        mass = weighted_slope = weighted_square = 0.0;
+        for(size_t i = 0; i < dim; i++)
+        {
+            const double h = curvature_weight(i);
+            slope -= distribution.val[i]*direction.val[i];
+            mass += h;
+            weighted_slope += h*direction.val[i];
+            weighted_square += h*direction.val[i]*direction.val[i];
+        }
+        curvature = (mass > 0.0)? eta*(weighted_square - weighted_slope*weighted_slope/mass) : 0.0;
+
+        if(std::fabs(slope) <= FrankWolfe::line_search_tol*std::fabs(initial_slope))
+        {
+            break;
+        }
+
+        if(slope < 0.0)
+        {
+            lower = gamma;
+            if(gamma >= gamma_max)
+            {
+                break;
+            }
+        }
+        else
+        {
+            upper = gamma;
+            upper_evaluated = true;
+        }
+    }
+
+    return gamma;
+}
+
+
+int FrankWolfeOptimizer::solve()
+{
+    return frank_wolfe_solve(0);
+}
+
+
+int FrankWolfeOptimizer::frank_wolfe_solve(const size_t previous_iterations)
+{
+    double *w = x.val;
+
+    double obj = start();
+
+    for(size_t i = 1; i <= FrankWolfe::max_iter; i++)
+    {
+        num_iterations = previous_iterations + i;
+
+        compute_edges();
+        const size_t toward = argmax(edges);
+
+        // the away vertex is the worst weak learner with some weight
+        size_t away = toward;
+        double weighted_edge = 0.0;
+        for(size_t j = 0; j < num_weak_learners; j++)
+        {
+            if(w[j] > 0.0)
+            {
+                weighted_edge += w[j]*edges.val[j];
+                if(w[away] == 0.0 or edges.val[j] < edges.val[away])
+                {
+                    away = j;
+                }
+            }
+        }
+
+        // Detect if we have already converged
+        if(gap_met(obj))
+        {
+            report_statistics();
+            return 0;
+        }
+
+        const double toward_gap = edge - weighted_edge;
+        const double away_gap = weighted_edge - edges.val[away];
+
+        if(toward_gap >= away_gap)
+        {
+            // w <- (1 - gamma) w + gamma e_toward
+            set_direction(toward, 1.0);
+            const double gamma = line_search(1.0, obj);
+            axpy(gamma, direction, margins, margins);
+            for(size_t j = 0; j < num_weak_learners; j++)
+            {
+                w[j] *= (1.0 - gamma);
+            }
+            w[toward] += gamma;
+        }
+        else
+        {
+            // w <- (1 + gamma) w - gamma e_away, the largest step
+            // drops the away weak learner
+            const double gamma_max = w[away]/(1.0 - w[away]);
+            set_direction(away, -1.0);
+            const double gamma = line_search(gamma_max, obj);
+            axpy(gamma, direction, margins, margins);
+            for(size_t j = 0; j < num_weak_learners; j++)
+            {
+                w[j] *= (1.0 + gamma);
+            }
+            w[away] = (gamma >= gamma_max)? 0.0 : w[away] - gamma;
+        }
+    } // end of "for each iteration"
+
+    std::cout << "Failure in Frank-Wolfe optimizer " << std::endl;
+    dual_obj = evaluate(margins, true);
+    return 1;
+}
+
+} // end of namespace totally_corrective_boosting
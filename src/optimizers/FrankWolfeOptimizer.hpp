@@ -0,0 +1,107 @@
+
+#ifndef _OPTIMIZER_FW_HPP_
+#define _OPTIMIZER_FW_HPP_
+
+#include "AbstractOptimizer.hpp"
+#include "math/capped_softmax.hpp"
+
+
+namespace totally_corrective_boosting
+{
+
+
+namespace FrankWolfe{
+const size_t max_iter = 100000;
+const size_t line_search_max_iter = 30;
+const double line_search_tol = 1e-3; // Slope reduction ending the line search
+}
+
+
+/// Implements the away-step Frank-Wolfe algorithm on the simplex of w
+///
+/// J. Guelat and P. Marcotte
+/// Some comments on Wolfe's 'away step'
+/// Math. Program., Vol. 35, No. 1, pp. 110-119
+///
+/// The psi (or beta, for binary ERLPBoost) are minimized out (see
+/// CappedSoftmax), so the objective only depends on the margins U w,
+/// which are kept up to date.
+/// A step moves the margins towards (or away from) a single column of U
+/// and its line search costs O(N) per trial (counted as a function
+/// evaluation), the edges U'd are computed once per iteration.
+/// The Frank-Wolfe gap max edge - w'U'd is the duality gap.
+class FrankWolfeOptimizer : public AbstractOptimizer {
+
+protected:
+
+    CappedSoftmax capped_softmax;
+
+    /// Optimal beta of the last binary evaluation (starts the next one)
+    double beta;
+
+    /// m = U w
+    DenseVector margins;
+
+    /// Change of the margins along the step
+    DenseVector direction;
+
+    /// margins + gamma*direction, tried by the line search
+    DenseVector trial_margins;
+
+    /// U'd
+    DenseVector edges;
+
+    /// m = U w, from scratch
+    void compute_margins();
+
+    /// Writes the distribution of the margins m (and psi or beta in x
+    /// if write_solution), counted as a function evaluation
+    /// @return the objective
+    double evaluate(const DenseVector& m, const bool write_solution = false);
+
+    /// Weight of example i in the second derivatives of the objective
+    /// w.r.t. the margins, eta (diag(h) - h h'/sum h)
+    double curvature_weight(const size_t i) const;
+
+    /// Sets up the margins, workspace and distribution of x
+    /// @return the objective
+    double start();
+
+    /// edges = U'd, and the max edge
+    void compute_edges();
+
+    /// Duality gap test at the current margins (of dual objective
+    /// objective), against tolerance_factor*gap_tolerance, psi is
+    /// written in x once it is met
+    bool gap_met(const double objective, const double tolerance_factor = 1.0);
+
+    /// direction = sign*(U_j - m)
+    void set_direction(const size_t j, const double sign);
+
+    /// Minimizes the objective along the direction for gamma in
+    /// [0, gamma_max], leaves the distribution at the returned gamma
+    /// @param objective in: the value at gamma = 0, out: at gamma
+    double line_search(const double gamma_max, double& objective);
+
+    /// Frank-Wolfe iterations from x, num_iterations counts them after
+    /// previous_iterations (those of the solver that handed over)
+    int frank_wolfe_solve(const size_t previous_iterations);
+
+public:
+
+    FrankWolfeOptimizer(const size_t& dim,
+                        const bool& transposed,
+                        const double& eta,
+                        const double& nu,
+                        const double& epsilon,
+                        const bool& binary);
+    ~FrankWolfeOptimizer();
+
+    void set_example_multiplicities(const DenseVector& multiplicities);
+
+    int solve();
+};
+
+} // end of namespace totally_corrective_boosting
+
+# endif
@@ -3,6 +3,7 @@
 
 #include "math/vector_operations.hpp"
 
+#include <cassert>
 #include <limits>
 #include <iostream>
 #include <cmath>
@@ -19,13 +20,24 @@ LbfgsbOptimizer::LbfgsbOptimizer(const size_t dim,
                                  const double epsilon,
                                  const bool binary)
     : AbstractOptimizer(dim, transposed, eta, nu, epsilon, binary),
-      lambda(0.0), mu(1.0)
+      lambda(0.0), mu(1.0),
+      warm_start(false),
+      has_warm_state(false),
+      lbfgs(LBFGSB::lbfgsb_m),
+      lbfgs_num_weak_learners(0), lbfgs_num_retired_columns(0)
 {
     // nothing to do here
     return;
 }
 
 
+void LbfgsbOptimizer::set_warm_start(const bool warm_start_)
+{
+    warm_start = warm_start_;
+    return;
+}
+
+
 LbfgsbOptimizer::~LbfgsbOptimizer()
 {
     // nothing to do here
@@ -35,33 +47,43 @@ LbfgsbOptimizer::~LbfgsbOptimizer()
 
 int LbfgsbOptimizer::solve()
 {
-    // Solution vector
-    ap::real_1d_array x0;
-    x0.setbounds(1, x.dim);
-
-    // copy current x into x0
-    for(size_t i = 0; i < x.dim; i++)
+    // Bounds, grown with some headroom
+    if(lower.capacity() < x.dim)
     {
-        x0(i+1) = x.val[i];
+        lower.reserve(x.dim + LBFGSB::workspace_headroom);
+        upper.reserve(x.dim + LBFGSB::workspace_headroom);
     }
+    lower.resize(x.dim);
+    upper.resize(x.dim);
 
-    ap::integer_1d_array nbd;
-    ap::real_1d_array l;
-    ap::real_1d_array u;
-    nbd.setbounds(1, x.dim);
-    l.setbounds(1, x.dim);
-    u.setbounds(1, x.dim);
-
-    // Set bounds
     if(binary)
     {
-        bounds_binary(nbd, l, u);
+        bounds_binary(lower, upper);
     }
     else
     {
-        bounds(nbd, l, u);
+        bounds(lower, upper);
     }
 
+    // Retired weak learners left x, the stored pairs no longer match it
+    if(num_retired_columns != lbfgs_num_retired_columns)
+    {
+        lbfgs.reset();
+        lbfgs_num_weak_learners = num_weak_learners;
+        lbfgs_num_retired_columns = num_retired_columns;
+    }
+
+    // The new weak learners come right after the previous ones in x,
+    // the stored pairs get zero entries for them
+    if(num_weak_learners > lbfgs_num_weak_learners)
+    {
+        lbfgs.insert_zero_coordinates(lbfgs_num_weak_learners,
+                                      num_weak_learners - lbfgs_num_weak_learners,
+                                      LBFGSB::workspace_headroom);
+        lbfgs_num_weak_learners = num_weak_learners;
+    }
+    lbfgs.reserve(x.dim, LBFGSB::workspace_headroom);
+
     // Lancelot: gamma_bar = 0.1
     double gamma_bar = 0.1; // < 1 :
 
@@ -88,7 +110,12 @@ int LbfgsbOptimizer::solve()
 
     double mu_bar = 0.9; // must be <= 1
 
-    mu = mu_bar;
+    // A warm start keeps the multiplier and the penalty of the previous solve,
+    // the tolerances restart from the penalty as in Lancelot
+    if(not (warm_start and has_warm_state))
+    {
+        mu = mu_bar;
+    }
 
     // Lancelot: alpha  = min(mu, gamma_bar)
     double alpha = std::min(mu, gamma_bar);
@@ -109,35 +136,35 @@ int LbfgsbOptimizer::solve()
 
     for(size_t iteration = 0; iteration < LBFGSB::max_iterations; iteration++)
     {
+        num_iterations = iteration + 1;
+
         double epsg = omega;
         double epsf = 0;
         double epsx = 0;
-        int info;
-
-        lbfgsbminimize(x.dim,
-                       std::min(x.dim, LBFGSB::lbfgsb_m),
-                       x0,
-                       epsg,
-                       epsf,
-                       epsx,
-                       LBFGSB::lbfgsb_max_iterations,
-                       nbd,
-                       l,
-                       u,
-                       (void*) this,
-                       info);
-
-        // copy current solution into x
-        for(size_t i = 0; i < x.dim; i++)
+
+        if(not warm_start)
         {
-            x.val[i] = x0(i+1);
+            lbfgs.reset();
         }
 
+        // works in place on x
+        const int info = lbfgs.minimize(*this,
+                                        x,
+                                        lower,
+                                        upper,
+                                        epsg,
+                                        epsf,
+                                        epsx,
+                                        LBFGSB::lbfgsb_max_iterations);
+
         const double w_gap = sum(W) - 1.0;
 
         // std::cout << "info: " << info << std::endl;
         // assert(info > 0);
-        assert(info == 4);
+        if(info != 4)
+        {
+            std::cout << "WARNING: lbfgs stopped before the gradient tolerance, info " << info << std::endl;
+        }
 
         if(std::abs(w_gap) < eta)
         {
@@ -176,6 +203,8 @@ int LbfgsbOptimizer::solve()
 
     } // end of "for each iteration"
 
+    has_warm_state = true;
+
     // This is not a memory leak!
     W.val = NULL;
     W.dim = 0;
@@ -184,16 +213,10 @@ int LbfgsbOptimizer::solve()
 } // end of LbfgsbOptimizer::solve()
 
 
-double LbfgsbOptimizer::augmented_lagrangian_and_function_gradient(
-        const ap::real_1d_array& x0,
-        ap::real_1d_array& g)
+double LbfgsbOptimizer::function_and_gradient(const DenseVector& x_, double *g)
 {
-
-    // Copy current iterate into solver solution vector
-    for(size_t i = 0; i < x.dim; i++)
-    {
-        x.val[i] = x0(i+1);
-    }
+    // lbfgs works in place on x
+    assert(x_.val == x.val);
 
     // Compute objective function
     double obj = function();
@@ -207,66 +230,55 @@ double LbfgsbOptimizer::augmented_lagrangian_and_function_gradient(
     obj -= lambda*(w_sum - 1.0);
     obj += (0.5*(w_sum - 1.0)*(w_sum - 1.0)/mu);
 
-    // Compute gradient
-    DenseVector _grad = gradient();
+    // Compute gradient, in place
+    gradient(g);
 
     for(size_t i = 0; i < num_weak_learners; i++)
     {
-        g(i+1) = _grad.val[i] - lambda + ((w_sum - 1.0)/mu);
-    }
-
-    for(size_t i = num_weak_learners; i < _grad.dim; i++)
-    {
-        g(i+1) = _grad.val[i];
+        g[i] = g[i] - lambda + ((w_sum - 1.0)/mu);
     }
 
     return obj;
 }
 
 
-void LbfgsbOptimizer::bounds(ap::integer_1d_array& nbd,
-                             ap::real_1d_array& l,
-                             ap::real_1d_array& u)
+void LbfgsbOptimizer::bounds(std::vector<double>& l,
+                             std::vector<double>& u)
 {
 
     // By default set lower bound to 0.0
     // By default set upper bound to 1.0
-    for(size_t i = 1; i <= x.dim; i++)
+    for(size_t i = 0; i < x.dim; i++)
     {
-        l(i) = 0.0;
-        u(i) = 1.0;
-        nbd(i) = 2;
+        l[i] = 0.0;
+        u[i] = 1.0;
     }
 
     // psi have essentially no upper bound
-    for(size_t i = num_weak_learners+1; i <= x.dim; i++)
+    for(size_t i = num_weak_learners; i < x.dim; i++)
     {
-        nbd(i) = 1;
-        u(i) = Optimizer::infinity;
+        u[i] = Optimizer::infinity;
     }
 
     return;
 }
 
 
-void LbfgsbOptimizer::bounds_binary(ap::integer_1d_array& nbd,
-                                    ap::real_1d_array& l,
-                                    ap::real_1d_array& u)
+void LbfgsbOptimizer::bounds_binary(std::vector<double>& l,
+                                    std::vector<double>& u)
 {
 
     // By default set lower bound to 0.0
     // By default set upper bound to 1.0
-    for(size_t i = 1; i <= x.dim; i++)
+    for(size_t i = 0; i < x.dim; i++)
     {
-        l(i) = 0.0;
-        u(i) = 1.0;
-        nbd(i) = 2;
+        l[i] = 0.0;
+        u[i] = 1.0;
     }
 
     // beta has no lower bound
-    nbd(num_weak_learners+1) = 0;
-    l(num_weak_learners+1) = -Optimizer::infinity;
-    u(num_weak_learners+1) = Optimizer::infinity;
+    l[num_weak_learners] = -Optimizer::infinity;
+    u[num_weak_learners] = Optimizer::infinity;
 
     return;
 }
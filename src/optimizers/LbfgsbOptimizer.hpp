@@ -3,7 +3,9 @@
 #define _OPTIMIZER_LBFGSB_HPP_
 
 #include "AbstractOptimizer.hpp"
-#include "lbfgsb/lbfgsb.h"
+#include "BoundedLbfgs.hpp"
+
+#include <vector>
 
 namespace totally_corrective_boosting
 {
@@ -13,11 +15,12 @@ namespace LBFGSB
 {
 const size_t max_iterations = 10000;
 const size_t lbfgsb_max_iterations = 1000;
-const size_t lbfgsb_m = 5; // Past gradients stored in lbfgsb
+const size_t lbfgsb_m = 5; // Past gradients stored in lbfgs
+const size_t workspace_headroom = 64; // Variables added when the workspaces grow
 }
 
 /// Augmented Lagrangian solver in the w domain.
-class LbfgsbOptimizer : public AbstractOptimizer
+class LbfgsbOptimizer : public AbstractOptimizer, public BoundedLbfgsObjective
 {
 
 private:
@@ -27,6 +30,22 @@ private:
     // Regularizer for the Lagrangian
     double mu;
 
+    /// Keep the L-BFGS pairs and the augmented Lagrangian
+    /// penalty mu between calls to solve()
+    bool warm_start;
+
+    /// true once solve() left a state to start from
+    bool has_warm_state;
+
+    /// Bounded L-BFGS, its pairs and workspace are kept between calls
+    BoundedLbfgs lbfgs;
+
+    /// Number of weak learners (and of retired ones) when lbfgs was last used
+    size_t lbfgs_num_weak_learners, lbfgs_num_retired_columns;
+
+    /// Bounds of x, allocated with headroom so that they rarely grow
+    std::vector<double> lower, upper;
+
 public:
 
     LbfgsbOptimizer(const size_t dim,
@@ -39,19 +58,19 @@ public:
 
     int solve();
 
-    void bounds(ap::integer_1d_array& nbd,
-                ap::real_1d_array& l,
-                ap::real_1d_array& u);
+    /// Warm start each solve from the previous one (default false)
+    void set_warm_start(const bool warm_start);
+
+    void bounds(std::vector<double>& l,
+                std::vector<double>& u);
 
-    void bounds_binary(ap::integer_1d_array& nbd,
-                       ap::real_1d_array& l,
-                       ap::real_1d_array& u);
+    void bounds_binary(std::vector<double>& l,
+                       std::vector<double>& u);
 
-    /// Take as input an array to return the gradient
+    /// Writes the gradient of the augmented lagrangian in g
     /// @return as output the objective value of augmented
     /// lagrangian
-    double augmented_lagrangian_and_function_gradient(const ap::real_1d_array& x0,
-                                                      ap::real_1d_array& g);
+    double function_and_gradient(const DenseVector& x, double *g);
 
 }; 
 
@@ -0,0 +1,383 @@
+
+#include "NewtonOptimizer.hpp"
+
+#include "math/vector_operations.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <iostream>
+
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+
+/// In place Cholesky factorization a = L L' of the n x n row major a
+/// (lower triangle), which must be positive definite
+void cholesky(std::vector<double>& a, const size_t n)
+{
+    for(size_t j = 0; j < n; j++)
+    {
+        double diagonal = a[j*n + j];
+        for(size_t k = 0; k < j; k++)
+        {
+            diagonal -= a[j*n + k]*a[j*n + k];
+        }
+        diagonal = std::sqrt(std::max(diagonal, std::numeric_limits<double>::min()));
+        a[j*n + j] = diagonal;
+
+        for(size_t i = j + 1; i < n; i++)
+        {
+            double value = a[i*n + j];
+            for(size_t k = 0; k < j; k++)
+            {
+                value -= a[i*n + k]*a[j*n + k];
+            }
+            a[i*n + j] = value/diagonal;
+        }
+    }
+    return;
+}
+
+
+/// Solves L L' x = b in place, l from cholesky()
+void cholesky_solve(const std::vector<double>& l, const size_t n, std::vector<double>& b)
+{
+    for(size_t i = 0; i < n; i++)
+    {
+        double value = b[i];
+        for(size_t k = 0; k < i; k++)
+        {
+            value -= l[i*n + k]*b[k];
+        }
+        b[i] = value/l[i*n + i];
+    }
+    for(size_t i = n; i-- > 0; )
+    {
+        double value = b[i];
+        for(size_t k = i + 1; k < n; k++)
+        {
+            value -= l[k*n + i]*b[k];
+        }
+        b[i] = value/l[i*n + i];
+    }
+    return;
+}
+
+} // end of anonymous namespace
+
+
+NewtonOptimizer::NewtonOptimizer(const size_t& dim,
+                                 const bool& transposed,
+                                 const double& eta,
+                                 const double& nu,
+                                 const double& epsilon,
+                                 const bool& binary):
+    FrankWolfeOptimizer(dim, transposed, eta, nu, epsilon, binary)
+{
+    // nothing to do here
+}
+
+
+NewtonOptimizer::~NewtonOptimizer()
+{
+    // nothing to do here
+}
+
+
+void NewtonOptimizer::compute_hessian()
+{
+    const size_t T = num_weak_learners;
+
+    // eta (U' diag(h) U - (U'h)(U'h)'/sum h), see curvature_weight()
+    hessian.assign(T*T, 0.0);
+    std::vector<double> weighted_edges(T, 0.0);
+    double weight_mass = 0.0;
+
+    // The columns of a block of examples are packed (and weighted by d)
+    // so that all the pairs of weak learners are done in cache
+    const size_t block = std::max(size_t(1), Newton::block_doubles/T);
+    const long num_blocks = (dim + block - 1)/block;
+
+#pragma omp parallel if(dim*T*T > Newton::parallel_threshold)
+    {
+        std::vector<double> local_hessian(T*T, 0.0);
+        std::vector<double> local_edges(T, 0.0);
+        double local_mass = 0.0;
+        std::vector<double> packed(T*block), weighted(T*block);
+
+#pragma omp for schedule(static)
+        for(long b = 0; b < num_blocks; b++)
+        {
+            const size_t begin = b*block;
+            const size_t length = std::min(block, dim - begin);
+
+            for(size_t r = 0; r < length; r++)
+            {
+                local_mass += curvature_weight(begin + r);
+            }
+
+            for(size_t j = 0; j < T; j++)
+            {
+                double *packed_j = &packed[j*block];
+                double *weighted_j = &weighted[j*block];
+                double edge_j = 0.0;
+                for(size_t r = 0; r < length; r++)
+                {
+                    const size_t i = begin + r;
+                    const double u = transposed? U[j].val[i] : U[i].val[j];
+                    const double h = curvature_weight(i);
+                    packed_j[r] = u;
+                    weighted_j[r] = h*u;
+                    edge_j += h*u;
+                }
+                local_edges[j] += edge_j;
+            }
+
+            for(size_t j = 0; j < T; j++)
+            {
+                const double *weighted_j = &weighted[j*block];
+                for(size_t k = j; k < T; k++)
+                {
+                    const double *packed_k = &packed[k*block];
+                    double sum = 0.0;
+#pragma omp simd reduction(+:sum)
+                    for(size_t r = 0; r < length; r++)
+                    {
+                        sum += weighted_j[r]*packed_k[r];
+                    }
+                    local_hessian[j*T + k] += sum;
+                }
+            }
+        }
+
+#pragma omp critical
+        {
+            for(size_t jk = 0; jk < T*T; jk++)
+            {
+                hessian[jk] += local_hessian[jk];
+            }
+            for(size_t j = 0; j < T; j++)
+            {
+                weighted_edges[j] += local_edges[j];
+            }
+            weight_mass += local_mass;
+        }
+    }
+
+    for(size_t j = 0; j < T; j++)
+    {
+        for(size_t k = j; k < T; k++)
+        {
+            double h = hessian[j*T + k];
+            if(weight_mass > 0.0)
+            {
+                h -= weighted_edges[j]*weighted_edges[k]/weight_mass;
+            }
+            hessian[j*T + k] = eta*h;
+            hessian[k*T + j] = eta*h;
+        }
+    }
+    return;
+}
+
+
+void NewtonOptimizer::solve_qp()
+{
+    // minimizes -edges'(v - w) + (v - w)'H(v - w)/2 over the simplex,
+    // moving on the face where v > 0
+    const size_t T = num_weak_learners;
+    const double *w = x.val;
+    target.assign(w, w + T);
+
+    double max_diagonal = 0.0;
+    for(size_t j = 0; j < T; j++)
+    {
+        max_diagonal = std::max(max_diagonal, hessian[j*T + j]);
+    }
+    const double delta = Newton::regularization*std::max(max_diagonal, 1.0);
+
+    std::vector<char> is_free(T);
+    for(size_t j = 0; j < T; j++)
+    {
+        is_free[j] = (target[j] > 0.0);
+    }
+
+    std::vector<double> model_gradient(T), factor, a, b;
+    std::vector<size_t> free_set;
+    const size_t max_qp_iter = std::max(size_t(100), 10*T);
+    for(size_t iter = 0; iter < max_qp_iter; iter++)
+    {
+        for(size_t j = 0; j < T; j++)
+        {
+            double g = -edges.val[j];
+            for(size_t k = 0; k < T; k++)
+            {
+                g += hessian[j*T + k]*(target[k] - w[k]);
+            }
+            model_gradient[j] = g;
+        }
+
+        free_set.clear();
+        for(size_t j = 0; j < T; j++)
+        {
+            if(is_free[j])
+            {
+                free_set.push_back(j);
+            }
+        }
+        const size_t n = free_set.size();
+
+        // Step p on the face: [H_FF 1; 1' 0][p; lambda] = [-g_F; 0]
+        factor.resize(n*n);
+        a.resize(n);
+        b.assign(n, 1.0);
+        for(size_t r = 0; r < n; r++)
+        {
+            for(size_t c = 0; c < n; c++)
+            {
+                factor[r*n + c] = hessian[free_set[r]*T + free_set[c]];
+            }
+            factor[r*n + r] += delta;
+            a[r] = model_gradient[free_set[r]];
+        }
+        cholesky(factor, n);
+        cholesky_solve(factor, n, a);
+        cholesky_solve(factor, n, b);
+
+        double sum_a = 0.0, sum_b = 0.0;
+        for(size_t r = 0; r < n; r++)
+        {
+            sum_a += a[r];
+            sum_b += b[r];
+        }
+        const double lambda = -sum_a/sum_b;
+
+        double step_norm = 0.0;
+        for(size_t r = 0; r < n; r++)
+        {
+            a[r] = -(a[r] + lambda*b[r]);
+            step_norm = std::max(step_norm, std::fabs(a[r]));
+        }
+
+        if(step_norm <= Newton::qp_tol)
+        {
+            // Optimal on the face, free the most violated bound if any
+            // (the multiplier of the simplex constraint is -lambda)
+            size_t entering = T;
+            double most_negative = -Newton::qp_tol*(1.0 + std::fabs(lambda));
+            for(size_t j = 0; j < T; j++)
+            {
+                if(not is_free[j] and model_gradient[j] + lambda < most_negative)
+                {
+                    most_negative = model_gradient[j] + lambda;
+                    entering = j;
+                }
+            }
+            if(entering == T)
+            {
+                return;
+            }
+            is_free[entering] = true;
+            continue;
+        }
+
+        // Longest step keeping v >= 0, the blocking variable leaves the face
+        double alpha = 1.0;
+        size_t blocking = T;
+        for(size_t r = 0; r < n; r++)
+        {
+            if(a[r] < 0.0 and -target[free_set[r]]/a[r] < alpha)
+            {
+                alpha = -target[free_set[r]]/a[r];
+                blocking = free_set[r];
+            }
+        }
+        for(size_t r = 0; r < n; r++)
+        {
+            target[free_set[r]] += alpha*a[r];
+        }
+        if(blocking != T)
+        {
+            target[blocking] = 0.0;
+            is_free[blocking] = false;
+        }
+    }
+    return;
+}
+
+
+int NewtonOptimizer::solve()
+{
+    if(num_weak_learners > Newton::max_weak_learners)
+    {
+        return frank_wolfe_solve(0);
+    }
+
+    double *w = x.val;
+
+    double obj = start();
+
+    for(size_t i = 1; i <= Newton::max_iter; i++)
+    {
+        num_iterations = i;
+
+        compute_edges();
+
+        // Detect if we have already converged
+        if(gap_met(obj))
+        {
+            report_statistics();
+            return 0;
+        }
+
+        compute_hessian();
+        solve_qp();
+
+        // The margins move by U (target - w)
+        for(size_t r = 0; r < dim; r++)
+        {
+            direction.val[r] = 0.0;
+        }
+        for(size_t j = 0; j < num_weak_learners; j++)
+        {
+            const double step = target[j] - w[j];
+            if(step == 0.0)
+            {
+                continue;
+            }
+            if(transposed)
+            {
+                axpy(step, U[j], direction, direction);
+            }
+            else
+            {
+                for(size_t r = 0; r < dim; r++)
+                {
+                    direction.val[r] += step*U[r].val[j];
+                }
+            }
+        }
+
+        const double gamma = line_search(1.0, obj);
+        if(gamma <= 0.0)
+        {
+            break;
+        }
+
+        axpy(gamma, direction, margins, margins);
+        for(size_t j = 0; j < num_weak_learners; j++)
+        {
+            w[j] += gamma*(target[j] - w[j]);
+        }
+    } // end of "for each iteration"
+
+    // Newton stalled, first order steps finish the job (the iterations
+    // of both are reported)
+    return frank_wolfe_solve(num_iterations);
+}
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,65 @@
+
+#ifndef _OPTIMIZER_NEWTON_HPP_
+#define _OPTIMIZER_NEWTON_HPP_
+
+#include "FrankWolfeOptimizer.hpp"
+
+#include <vector>
+
+
+namespace totally_corrective_boosting
+{
+
+
+namespace Newton{
+const size_t max_weak_learners = 200; // Larger problems are left to Frank-Wolfe
+const size_t max_iter = 50; // Then Frank-Wolfe finishes the solve
+const size_t block_doubles = 16384; // Packed entries of U per block of examples
+const size_t parallel_threshold = 1 << 20; // Smaller N*T*T use a single thread
+const double regularization = 1e-10; // Added to the Hessian, relative to its diagonal
+const double qp_tol = 1e-12;
+}
+
+
+/// Implements a projected Newton method on the simplex of w, for small
+/// ensembles (T weak learners, N examples, T << N).
+///
+/// As in FrankWolfeOptimizer, psi (or beta) are minimized out.
+/// Each iteration forms the T x T Hessian
+///   eta (U' diag(h) U - (U'h)(U'h)'/sum h)
+/// (h = d on the uncapped examples, see curvature_weight) in O(N T^2),
+/// minimizes the quadratic model over the simplex with a primal active
+/// set method and searches along the step in O(N) per trial. Past
+/// max_weak_learners, or when a Newton step stalls, the solve is done by
+/// Frank-Wolfe.
+class NewtonOptimizer : public FrankWolfeOptimizer {
+
+protected:
+
+    /// Hessian w.r.t. w, T x T row major
+    std::vector<double> hessian;
+
+    /// Minimizer of the quadratic model
+    std::vector<double> target;
+
+    void compute_hessian();
+
+    /// Active set method on the quadratic model, from w, result in target
+    void solve_qp();
+
+public:
+
+    NewtonOptimizer(const size_t& dim,
+                    const bool& transposed,
+                    const double& eta,
+                    const double& nu,
+                    const double& epsilon,
+                    const bool& binary);
+    ~NewtonOptimizer();
+
+    int solve();
+};
+
+} // end of namespace totally_corrective_boosting
+
+# endif
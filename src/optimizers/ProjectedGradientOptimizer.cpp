@@ -2,7 +2,9 @@
 #include "ProjectedGradientOptimizer.hpp"
 
 #include "math/vector_operations.hpp"
+#include "Profiler.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 #include <iostream>
@@ -64,13 +66,13 @@ double phi(DenseVector& x,
 //        l \leq x \leq u  
 //
 
-size_t ProjectedGradientOptimizer::project(DenseVector& x,
-                                           const DenseVector& a,
-                                           const double& b,
-                                           const DenseVector& z,
-                                           const DenseVector& l,
-                                           const DenseVector& u,
-                                           const size_t& max_iter){
+size_t dai_fletcher_project(DenseVector& x,
+                            const DenseVector& a,
+                            const double& b,
+                            const DenseVector& z,
+                            const DenseVector& l,
+                            const DenseVector& u,
+                            const size_t& max_iter){
 
     double r, r_l, r_u, s;
     double d_lambda = 0.5, lambda = 0.0;
@@ -183,59 +185,26 @@ size_t ProjectedGradientOptimizer::project(DenseVector& x,
 
 void ProjectedGradientOptimizer::project_erlp(DenseVector& x){
 
-    // Create vectors of zeros
-    DenseVector a(x.dim, 0.0);
-    // Fill the first num_wl values corresponding to w with 1
-    // The rest which correspond to psi are simply 0
-    for(size_t i = 0; i < num_weak_learners; i++)
-        a.val[i] = 1.0;
+    PROFILE_SCOPE(Profiler::projection);
 
-    double b = 1.0;
-
-    // z is simply a copy of x before projection
-    DenseVector z(x);
-
-    // Lower bound for all our variables is 0.0
-    DenseVector l(x.dim, 0.0);
-
-    // Create vector of ones
-    // That is the upper bound on w
-    DenseVector u(x.dim, 1.0);
+    // w on the simplex
+    simplex_projection.project(x, num_weak_learners, x.dim, 1.0);
 
     // psi have essentially no upper bound
     for(size_t i = num_weak_learners; i < x.dim; i++)
     {
-        u.val[i] = Optimizer::infinity;
+        x.val[i] = std::max(x.val[i], 0.0);
     }
 
-    project(x, a, b, z, l, u, DaiAndFletcher::max_iter);
-
     return;
 }
 
 void ProjectedGradientOptimizer::project_binary(DenseVector& x){
 
-    // Create vectors of ones
-    DenseVector a(x.dim, 1.0);
-    // Set coefficient for beta = 0
-    a.val[num_weak_learners] = 0.0;
-    double b = 1.0;
+    PROFILE_SCOPE(Profiler::projection);
 
-    // z is simply a copy of x before projection
-    DenseVector z(x);
-
-    // Lower bound for all our variables is 0.0
-    DenseVector l(x.dim, 0.0);
-    // Except for beta it does not matter
-    l.val[num_weak_learners] = -Optimizer::infinity;
-
-    // Create vector of ones
-    // That is the upper bound on w
-    DenseVector u(x.dim, 1.0);
-    // Except for beta it does not matter
-    u.val[num_weak_learners] = Optimizer::infinity;
-
-    project(x, a, b, z, l, u, DaiAndFletcher::max_iter);
+    // All but beta on the simplex, beta is free
+    simplex_projection.project(x, num_weak_learners, num_weak_learners + 1, 1.0);
 
     return;
 }
@@ -277,6 +246,8 @@ int ProjectedGradientOptimizer::solve(){
 
     for(size_t i = 1; i <= ProjectedGradient::max_iter; i++){
 
+        num_iterations = i;
+
         // Step 1: Detect if we have already converged
         if(duality_gap_met()){
             report_statistics();
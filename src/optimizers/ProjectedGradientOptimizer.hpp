@@ -3,6 +3,7 @@
 #define _OPTIMIZER_PG_HPP_
 
 #include "AbstractOptimizer.hpp"
+#include "math/simplex_projection.hpp"
 
 
 namespace totally_corrective_boosting
@@ -67,19 +68,25 @@ double phi(DenseVector& x,
            const DenseVector& u,
            const double& lambda);
 
-class ProjectedGradientOptimizer : public AbstractOptimizer {
-
-private:
+/// Dai-Fletcher projection of z onto {a'x = b, l <= x <= u}, written in x
+/// (general singly linearly constrained case, see SimplexProjection for
+/// the sets of ERLPBoost)
+/// @returns the number of secant iterations
+size_t dai_fletcher_project(DenseVector& x,
+                            const DenseVector& a,
+                            const double& b,
+                            const DenseVector& z,
+                            const DenseVector& l,
+                            const DenseVector& u,
+                            const size_t& max_iter);
 
-    size_t project(DenseVector& x,
-                   const DenseVector& a,
-                   const double& b,
-                   const DenseVector& z,
-                   const DenseVector& l,
-                   const DenseVector& u,
-                   const size_t& max_iter);
+class ProjectedGradientOptimizer : public AbstractOptimizer {
 
 protected:
+    /// w (and the rho of the binary problem) lie on the simplex,
+    /// the upper bounds w <= 1 are implied by it
+    SimplexProjection simplex_projection;
+
     void project_erlp(DenseVector& z);
 
     void project_binary(DenseVector& z);
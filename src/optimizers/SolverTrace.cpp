@@ -0,0 +1,187 @@
+#include "SolverTrace.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace totally_corrective_boosting
+{
+
+namespace
+{
+const char trace_magic[8] = {'T', 'C', 'B', 'T', 'R', 'A', 'C', 'E'};
+const uint64_t trace_version = 2;
+
+template<class T>
+void write_value(std::ofstream &output_stream, const T &value)
+{
+    output_stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    return;
+}
+
+template<class T>
+void read_value(std::ifstream &input_stream, T &value)
+{
+    input_stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return;
+}
+}
+
+
+SolveStatistics::SolveStatistics()
+    : iterations(0), function_evaluations(0), gradient_evaluations(0),
+      time(0), dual_objective(0), min_primal(0), gap_tolerance(0)
+{
+    // nothing to do here
+}
+
+
+SolverTraceWriter::SolverTraceWriter(const std::string &filename,
+                                     const size_t dim,
+                                     const double eta, const double nu, const double epsilon,
+                                     const bool binary,
+                                     const DenseVector &distribution)
+    : output_stream(filename.c_str(), std::ios::binary)
+{
+    if(not output_stream.good())
+    {
+        std::stringstream os;
+        os << "Cannot open solver trace file : " << filename << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    output_stream.write(trace_magic, sizeof(trace_magic));
+    write_value(output_stream, trace_version);
+    write_value(output_stream, uint64_t(dim));
+    write_value(output_stream, eta);
+    write_value(output_stream, nu);
+    write_value(output_stream, epsilon);
+    write_value(output_stream, uint8_t(binary));
+    output_stream.write(reinterpret_cast<const char *>(distribution.val), distribution.dim*sizeof(double));
+    return;
+}
+
+
+void SolverTraceWriter::push_back(const SparseVector &column)
+{
+    write_value(output_stream, 'C');
+    write_value(output_stream, uint64_t(column.nnz));
+    write_value(output_stream, uint64_t(column.dim));
+    for(size_t k = 0; k < column.nnz; k++)
+    {
+        write_value(output_stream, uint64_t(column.index[k]));
+    }
+    output_stream.write(reinterpret_cast<const char *>(column.val), column.nnz*sizeof(double));
+    return;
+}
+
+
+void SolverTraceWriter::solve(const SolveStatistics &statistics)
+{
+    write_value(output_stream, 'S');
+    write_value(output_stream, statistics.iterations);
+    write_value(output_stream, statistics.function_evaluations);
+    write_value(output_stream, statistics.gradient_evaluations);
+    write_value(output_stream, statistics.time);
+    write_value(output_stream, statistics.dual_objective);
+    write_value(output_stream, statistics.min_primal);
+    write_value(output_stream, statistics.gap_tolerance);
+
+    // a trace should be usable even if the booster does not finish
+    output_stream.flush();
+    return;
+}
+
+
+SolverTraceReader::SolverTraceReader(const std::string &filename_)
+    : input_stream(filename_.c_str(), std::ios::binary),
+      filename(filename_)
+{
+    char magic[sizeof(trace_magic)];
+    uint64_t version = 0, trace_dim = 0;
+    uint8_t trace_binary = 0;
+
+    input_stream.read(magic, sizeof(magic));
+    read_value(input_stream, version);
+    if(not input_stream.good()
+            or std::memcmp(magic, trace_magic, sizeof(magic)) != 0
+            or version != trace_version)
+    {
+        std::stringstream os;
+        os << "Not a solver trace (or written by another version) : " << filename << std::endl;
+        throw std::invalid_argument(os.str());
+    }
+
+    read_value(input_stream, trace_dim);
+    read_value(input_stream, eta);
+    read_value(input_stream, nu);
+    read_value(input_stream, epsilon);
+    read_value(input_stream, trace_binary);
+
+    dim = trace_dim;
+    binary = (trace_binary != 0);
+    distribution.resize(dim);
+    input_stream.read(reinterpret_cast<char *>(distribution.val), dim*sizeof(double));
+
+    if(not input_stream.good())
+    {
+        std::stringstream os;
+        os << "Truncated solver trace : " << filename << std::endl;
+        throw std::runtime_error(os.str());
+    }
+    return;
+}
+
+
+bool SolverTraceReader::next(SolverTraceEvent &event)
+{
+    char type = 0;
+    if(not input_stream.read(&type, 1))
+    {
+        return false;
+    }
+
+    if(type == 'C')
+    {
+        uint64_t nnz = 0, column_dim = 0;
+        read_value(input_stream, nnz);
+        read_value(input_stream, column_dim);
+
+        event.type = SolverTraceEvent::column;
+        event.column_values.resize(column_dim, nnz);
+        for(size_t k = 0; k < nnz; k++)
+        {
+            uint64_t index = 0;
+            read_value(input_stream, index);
+            event.column_values.index[k] = index;
+        }
+        input_stream.read(reinterpret_cast<char *>(event.column_values.val), nnz*sizeof(double));
+    }
+    else if(type == 'S')
+    {
+        event.type = SolverTraceEvent::solve;
+        read_value(input_stream, event.statistics.iterations);
+        read_value(input_stream, event.statistics.function_evaluations);
+        read_value(input_stream, event.statistics.gradient_evaluations);
+        read_value(input_stream, event.statistics.time);
+        read_value(input_stream, event.statistics.dual_objective);
+        read_value(input_stream, event.statistics.min_primal);
+        read_value(input_stream, event.statistics.gap_tolerance);
+    }
+    else
+    {
+        std::stringstream os;
+        os << "Unknown event '" << type << "' in solver trace : " << filename << std::endl;
+        throw std::runtime_error(os.str());
+    }
+
+    if(not input_stream.good())
+    {
+        std::stringstream os;
+        os << "Truncated solver trace : " << filename << std::endl;
+        throw std::runtime_error(os.str());
+    }
+    return true;
+}
+
+} // end of namespace totally_corrective_boosting
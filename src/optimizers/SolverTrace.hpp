@@ -0,0 +1,121 @@
+#ifndef TOTALLY_CORRECTIVE_BOOSTING_SOLVERTRACE_HPP
+#define TOTALLY_CORRECTIVE_BOOSTING_SOLVERTRACE_HPP
+
+#include "math/dense_vector.hpp"
+#include "math/sparse_vector.hpp"
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+
+namespace totally_corrective_boosting
+{
+
+/// Effort and result of one call to AbstractOptimizer::solve()
+class SolveStatistics
+{
+public:
+    uint64_t iterations;
+    uint64_t function_evaluations;
+    uint64_t gradient_evaluations;
+
+    /// Wall clock time, in seconds
+    double time;
+
+    double dual_objective;
+    double min_primal;
+
+    /// Duality gap the solve was asked to reach (see
+    /// AbstractOptimizer::set_gap_tolerance), replays solve to the same one
+    double gap_tolerance;
+
+    SolveStatistics();
+};
+
+
+/// Sequence of problems seen by the optimizer of a totally corrective booster.
+///
+/// A trace holds the parameters of the problem (dim, eta, nu, epsilon,
+/// binary), the initial distribution, then the columns given to
+/// AbstractOptimizer::push_back and the calls to solve() (with their
+/// recorded statistics and gap tolerance), in order. The working set
+/// of weak learners is not recorded, boosters_factory refuses to trace
+/// with retire_after > 0. Replaying it (see replay_solver) feeds
+/// any optimizer with the exact problems of a real boosting run, without
+/// the oracle.
+///
+/// Binary layout (native endianness):
+///   "TCBTRACE", uint64 version, uint64 dim, double eta, nu, epsilon,
+///   uint8 binary, dim doubles distribution, then events:
+///   'C' uint64 nnz, uint64 dim, nnz uint64 indices, nnz double values
+///   'S' SolveStatistics fields
+class SolverTraceWriter
+{
+
+protected:
+
+    std::ofstream output_stream;
+
+public:
+
+    SolverTraceWriter(const std::string &filename,
+                      const size_t dim,
+                      const double eta, const double nu, const double epsilon,
+                      const bool binary,
+                      const DenseVector &distribution);
+
+    void push_back(const SparseVector &column);
+
+    void solve(const SolveStatistics &statistics);
+
+};
+
+
+class SolverTraceEvent
+{
+public:
+    enum Type
+    {
+        column,
+        solve
+    };
+
+    Type type;
+
+    /// Defined for column events
+    SparseVector column_values;
+
+    /// Recorded when tracing, defined for solve events
+    SolveStatistics statistics;
+};
+
+
+class SolverTraceReader
+{
+
+protected:
+
+    std::ifstream input_stream;
+
+    const std::string filename;
+
+public:
+
+    size_t dim;
+    double eta, nu, epsilon;
+    bool binary;
+
+    /// Distribution given to the optimizer before the first column
+    DenseVector distribution;
+
+    /// Reads the header of the trace
+    SolverTraceReader(const std::string &filename);
+
+    /// Reads the next event, returns false at the end of the trace
+    bool next(SolverTraceEvent &event);
+
+};
+
+} // end of namespace totally_corrective_boosting
+
+#endif // TOTALLY_CORRECTIVE_BOOSTING_SOLVERTRACE_HPP
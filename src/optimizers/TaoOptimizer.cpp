@@ -113,6 +113,8 @@ int TaoOptimizer::solve(){
   info = TaoSetTolerances(tao, 0, 0, 0, 0); CHKERRQ(info);
   
   for(size_t iter = 0; iter < TAO::max_iter; iter++){
+
+    num_iterations = iter + 1;
     
     info = TaoSetGradientTolerances(tao, omega, 0, 0); CHKERRQ(info);
     // seed with old solution
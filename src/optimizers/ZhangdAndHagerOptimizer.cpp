@@ -51,6 +51,7 @@ int ZhangdAndHagerOptimizer::solve(){
 
     for(size_t i = 1; i <= ProjGrad_HZ::max_iter; i++)
     {
+        num_iterations = i;
 
         // Step 1: Detect if we have already converged
         if(duality_gap_met())
@@ -2,6 +2,9 @@
 
 #include "ProjectedGradientOptimizer.hpp"
 #include "ZhangdAndHagerOptimizer.hpp"
+#include "FistaOptimizer.hpp"
+#include "FrankWolfeOptimizer.hpp"
+#include "NewtonOptimizer.hpp"
 #include "LbfgsbOptimizer.hpp"
 #include "CoordinateDescentOptimizer.hpp"
 
@@ -51,9 +54,28 @@ AbstractOptimizer* new_optimizer_instance(
     {
         optimizer = new ZhangdAndHagerOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
     }
+    else if(optimizer_type == "fista")
+    {
+        optimizer = new FistaOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
+    }
+    else if(optimizer_type == "fw")
+    {
+        optimizer = new FrankWolfeOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
+    }
+    else if(optimizer_type == "newton")
+    {
+        optimizer = new NewtonOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
+    }
     else if(optimizer_type == "lbfgsb")
     {
-        optimizer = new LbfgsbOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
+        LbfgsbOptimizer *lbfgsb_optimizer = new LbfgsbOptimizer(labels_size, transposed, eta, nu, epsilon, binary);
+
+        bool warm_start = false;
+        config.readInto(warm_start, "lbfgsb_warm_start", false);
+        lbfgsb_optimizer->set_warm_start(warm_start);
+        log_stream << "lbfgsb_warm_start == " << (warm_start? "true" : "false") << std::endl;
+
+        optimizer = lbfgsb_optimizer;
     }
     else if(optimizer_type == "cd")
     {
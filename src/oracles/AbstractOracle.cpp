@@ -1,24 +1,107 @@
 
 #include "AbstractOracle.hpp"
 
+#include "MemoryAccounting.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
 namespace totally_corrective_boosting
 {
 
+namespace
+{
+
+/// Orders indices by decreasing score
+struct ScoreGreater
+{
+    const std::vector<double>& scores;
+
+    ScoreGreater(const std::vector<double>& scores): scores(scores) {}
+
+    bool operator()(const size_t a, const size_t b) const
+    {
+        return scores[a] > scores[b] or (scores[a] == scores[b] and a < b);
+    }
+};
+
+} // end of anonymous namespace
+
+
 AbstractOracle::AbstractOracle(const std::vector<SparseVector>& data,
                                const std::vector<int>& labels,
                                const bool transposed)
-    : data(data), labels(labels), transposed(transposed)
+    : data(data), labels(labels), transposed(transposed),
+      weak_learner_pool(new WeakLearnerPool), num_original_features(0)
 {
-    // nothing to do here
+    MemoryAccounting::allocate(MemoryAccounting::data, MemoryAccounting::bytes(this->data));
     return;
 }
 
 
 AbstractOracle::~AbstractOracle()
 {
-    // nothing to do here
+    MemoryAccounting::release(MemoryAccounting::data, MemoryAccounting::bytes(data));
+    return;
+}
+
+
+void AbstractOracle::set_weak_learner_pool(const boost::shared_ptr<WeakLearnerPool>& pool)
+{
+    if(not pool)
+    {
+        throw std::invalid_argument("AbstractOracle::set_weak_learner_pool needs a weak learner pool");
+    }
+    weak_learner_pool = pool;
     return;
 }
 
 
+void AbstractOracle::set_original_features(const std::vector<size_t>& original_features_,
+                                           const size_t num_features)
+{
+    if(not transposed)
+    {
+        throw std::invalid_argument("AbstractOracle::set_original_features needs the transposed data");
+    }
+    if(original_features_.size() != data.size())
+    {
+        throw std::invalid_argument("AbstractOracle::set_original_features needs one index per feature");
+    }
+    for(size_t k = 0; k < original_features_.size(); k++)
+    {
+        if(original_features_[k] >= num_features)
+        {
+            throw std::invalid_argument("AbstractOracle::set_original_features received an index out of range");
+        }
+    }
+    original_features = original_features_;
+    num_original_features = num_features;
+    return;
+}
+
+
+std::vector<size_t> AbstractOracle::top_k_indices(const std::vector<double>& scores, const size_t k)
+{
+    std::vector<size_t> indices(scores.size());
+    for(size_t i = 0; i < indices.size(); i++)
+    {
+        indices[i] = i;
+    }
+    const size_t num_selected = std::min(k, indices.size());
+    std::partial_sort(indices.begin(), indices.begin() + num_selected, indices.end(),
+                      ScoreGreater(scores));
+    indices.resize(num_selected);
+    return indices;
+}
+
+
+std::vector<AbstractWeakLearner*> AbstractOracle::find_top_k_weak_learners(const DenseVector& distribution,
+                                                                           const size_t /*k*/)
+{
+    return std::vector<AbstractWeakLearner*>(1, find_maximum_edge_weak_learner(distribution));
+}
+
+
 } // end of namespace totally_corrective_boosting
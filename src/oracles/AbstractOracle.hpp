@@ -4,12 +4,15 @@
 
 #include "math/vector_operations.hpp"
 
+#include <boost/shared_ptr.hpp>
+
 #include <vector>
 
 namespace totally_corrective_boosting
 {
 
 class AbstractWeakLearner; // forward declaration
+class WeakLearnerPool; // forward declaration
 
 /// Base class to encapsulate a oracle. It essentially represents a set
 /// of weak learners. Given a distribution over data it picks out the
@@ -24,6 +27,34 @@ protected:
 
     const bool transposed;
 
+    /// Where the weak learners returned are allocated
+    boost::shared_ptr<WeakLearnerPool> weak_learner_pool;
+
+    /// Index in the full training data of each feature of data, empty
+    /// if data has all the features (see compact_features)
+    std::vector<size_t> original_features;
+
+    /// Number of features of the full training data, if original_features is set
+    size_t num_original_features;
+
+    /// Index of feature in the full training data, the weak learners
+    /// returned use it so that the model applies to the full data
+    size_t original_feature(const size_t feature) const
+    {
+        return original_features.empty()? feature : original_features[feature];
+    }
+
+    /// Number of features of the full training data, num_features
+    /// (the number of features of data) if nothing was compacted
+    size_t original_num_features(const size_t num_features) const
+    {
+        return original_features.empty()? num_features : num_original_features;
+    }
+
+    /// Indices of the (at most) k largest scores, by decreasing score
+    /// (ties by increasing index)
+    static std::vector<size_t> top_k_indices(const std::vector<double>& scores, const size_t k);
+
 public:
     AbstractOracle(const std::vector<SparseVector>& data,
                    const std::vector<int>& labels,
@@ -31,9 +62,27 @@ public:
 
     virtual ~AbstractOracle();
 
+    /// The weak learners returned from now on are allocated from (and owned by) pool.
+    /// The boosters pass the pool of their model, the oracle starts with a pool of its own
+    void set_weak_learner_pool(const boost::shared_ptr<WeakLearnerPool>& pool);
+
+    /// data holds only some features of the (transposed) training data,
+    /// its feature k is the feature original_features[k] of the
+    /// num_features ones. The weak learners returned refer to the
+    /// original features
+    void set_original_features(const std::vector<size_t>& original_features,
+                               const size_t num_features);
+
     /// given distribution return weak learner with maximum edge
-    /// (should return a new instance, the receiver is responsible of the weak learner object destruction)
+    /// (should return a new instance, allocated from the weak learner pool, which owns it)
     virtual AbstractWeakLearner* find_maximum_edge_weak_learner(const DenseVector& distribution) = 0;
+
+    /// given distribution return (at most) k weak learners with the largest
+    /// edges, one per feature, by decreasing edge (the first one is the
+    /// maximum edge weak learner). Same ownership as above.
+    /// The default implementation only returns the maximum edge weak learner
+    virtual std::vector<AbstractWeakLearner*> find_top_k_weak_learners(const DenseVector& distribution,
+                                                                       const size_t k);
 };
 
 } // end of namespace totally_corrective_boosting
@@ -1,64 +1,96 @@
 
 #include "DecisionStump.hpp"
 
-#include "weak_learners/DecisionStumpWeakLearner.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
+#include "MemoryAccounting.hpp"
+#include "Profiler.hpp"
 
 #include <algorithm>
+#include <cassert>
 
 namespace totally_corrective_boosting
 {
 
+namespace
+{
+
+/// Copy of data with the binary features (all nonzero entries 1) pattern-only
+std::vector<SparseVector> pattern_only_binary_features(const std::vector<SparseVector>& data)
+{
+    std::vector<SparseVector> result(data);
+    for(size_t i = 0; i < result.size(); i++)
+    {
+        result[i].drop_unit_values();
+    }
+    return result;
+}
+
+} // end of anonymous namespace
+
+
 DecisionStump::DecisionStump(const std::vector<SparseVector>& data,
                              const std::vector<int>& labels,
                              const bool less_than):
-    AbstractOracle(data, labels), less_than(less_than)
+    AbstractOracle(pattern_only_binary_features(data), labels, true), less_than(less_than)
 {
 
     // sorted_data is a matrix where each column is the
     // argsort value of the corresponding hypothesis
     // we sort the data upon initialization so we only have to
     // do it once.
+    // The binary features need no sorting, their entry stays empty
 
-    Timer sort_timer;
-    std::vector<SparseVector>::const_iterator it;
-    sort_timer.start();
-    for(it = data.begin(); it != data.end(); ++it)
+    PROFILE_SCOPE(Profiler::oracle_sort);
+    size_t num_pattern_only = 0;
+    sorted_data.resize(this->data.size());
+    for(size_t i = 0; i < this->data.size(); i++)
     {
-        DenseIntegerVector tmp = argsort(*it);
-        sorted_data.push_back(tmp);
+        if(this->data[i].pattern_only())
+        {
+            num_pattern_only++;
+            continue;
+        }
+        sorted_data[i] = argsort(this->data[i]);
+        MemoryAccounting::allocate(MemoryAccounting::sorted_data, MemoryAccounting::bytes(sorted_data[i]));
     }
-    sort_timer.stop();
-    std::cout << "Sorting time: " << sort_timer.last_cpu << std::endl;
+    std::cout << "Binary features (not sorted): " << num_pattern_only
+              << " of " << this->data.size() << std::endl;
     return;
 }
 
 
 DecisionStump::~DecisionStump()
 {
-    std::cout << "Total time spent in the DecisionStump weak learner (aka the oracle): "
-              << timer.total_cpu << " seconds" << std::endl;
+    for(size_t i = 0; i < sorted_data.size(); i++)
+    {
+        MemoryAccounting::release(MemoryAccounting::sorted_data, MemoryAccounting::bytes(sorted_data[i]));
+    }
     return;
 }
 
 
+double DecisionStump::initial_edge(const DenseVector& dist) const
+{
+    // edge of a hypothesis that always predicts 1
+    double init_edge = 0.0;
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+        init_edge += dist.val[i]*labels[i];
+    }
+    return init_edge;
+}
+
+
 AbstractWeakLearner* DecisionStump::find_maximum_edge_weak_learner(const DenseVector& dist)
 {
 
     double best_threshold = 1.0;
     double best_edge = -1.0;
-    bool ge;
+    bool ge = true;
     size_t max_index = 0;
     size_t size = data.size();
-    double init_edge = 0.0;
 
-    timer.start();
-
-    // compute the initial edge for a hypothesis
-    // that always predicts 1
-    for(size_t i = 0; i < labels.size(); i++)
-    {
-        init_edge += dist.val[i]*labels[i];
-    }
+    const double init_edge = initial_edge(dist);
 
     for(size_t i = 0; i < size; i++){
         double tmp_threshold;
@@ -75,6 +107,52 @@ AbstractWeakLearner* DecisionStump::find_maximum_edge_weak_learner(const DenseVe
         }
     }
 
+    AbstractWeakLearner* wl = make_weak_learner(max_index, best_threshold, ge, dist);
+
+    return wl;
+}
+
+
+std::vector<AbstractWeakLearner*> DecisionStump::find_top_k_weak_learners(const DenseVector& dist,
+                                                                          const size_t k)
+{
+    const size_t size = data.size();
+    std::vector<double> thresholds(size), edges(size);
+    std::vector<bool> ges(size);
+
+    const double init_edge = initial_edge(dist);
+
+    // the scan finds the best stump of every feature anyway
+    for(size_t i = 0; i < size; i++)
+    {
+        double tmp_threshold;
+        double tmp_edge;
+        bool tmp_ge;
+
+        find_best_threshold(i, dist, init_edge, tmp_threshold, tmp_edge, tmp_ge);
+
+        thresholds[i] = tmp_threshold;
+        edges[i] = tmp_edge;
+        ges[i] = tmp_ge;
+    }
+
+    const std::vector<size_t> selected = top_k_indices(edges, k);
+    std::vector<AbstractWeakLearner*> weak_learners;
+    for(size_t j = 0; j < selected.size(); j++)
+    {
+        const size_t index = selected[j];
+        weak_learners.push_back(make_weak_learner(index, thresholds[index], ges[index], dist));
+    }
+
+    return weak_learners;
+}
+
+
+AbstractWeakLearner* DecisionStump::make_weak_learner(const size_t max_index,
+                                                      const double best_threshold,
+                                                      const bool ge,
+                                                      const DenseVector& dist) const
+{
     SparseVector prediction(data[max_index].dim, data[max_index].dim);
 
     // initially set result to zero
@@ -88,7 +166,7 @@ AbstractWeakLearner* DecisionStump::find_maximum_edge_weak_learner(const DenseVe
     for(size_t i = 0; i < data[max_index].nnz; i++)
     {
         size_t index = data[max_index].index[i];
-        prediction.val[index] = data[max_index].val[i];
+        prediction.val[index] = data[max_index].value(i);
     }
 
     double edge = 0.0; // just for checking that we're thresholding well
@@ -110,23 +188,19 @@ AbstractWeakLearner* DecisionStump::find_maximum_edge_weak_learner(const DenseVe
         prediction.val[i] *= labels[i];
         edge += prediction.val[i]*dist.val[i];
     }
-    SparseVector wt(size, 1);
-    wt.index[0] = max_index;
+    SparseVector wt(original_num_features(data.size()), 1);
+    wt.index[0] = original_feature(max_index);
     wt.val[0] = 1.0;
 
     //std::cout << "thresh: " << best_threshold << " dir: " << ge;
     //std::cout << " index: " << max_index << " edge: " << edge << std::endl;
 
-    AbstractWeakLearner* wl = new DecisionStumpWeakLearner(wt,
-                                                           edge,
-                                                           prediction,
-                                                           best_threshold,
-                                                           ge,
-                                                           max_index);
-
-    timer.stop();
-    std::cout << "Weak learner time: " << timer.last_cpu << " seconds" << std::endl;
-    return wl;
+    return weak_learner_pool->new_stump(wt,
+                                        edge,
+                                        prediction,
+                                        best_threshold,
+                                        ge,
+                                        original_feature(max_index));
 }
 
 
@@ -137,6 +211,7 @@ void DecisionStump::find_best_threshold_greater_or_equal(const size_t& index,
                                                          double& best_threshold,
                                                          double& best_edge) const
 {
+    assert(not data[index].pattern_only());
 
     DenseIntegerVector indices = sorted_data[index]; // sorted indices for hyp index
     double max_so_far = init_edge;
@@ -211,6 +286,7 @@ void DecisionStump::find_best_threshold_less_or_equal(const size_t& index,
                                                       double& best_threshold,
                                                       double& best_edge) const
 {
+    assert(not data[index].pattern_only());
 
     DenseIntegerVector indices = sorted_data[index]; // sorted indices for hyp index
     double max_so_far = init_edge;
@@ -271,6 +347,12 @@ void DecisionStump::find_best_threshold(const size_t& index,
                                         bool& ge) const
 {
 
+    if(data[index].pattern_only())
+    {
+        find_best_threshold_pattern_only(index, dist, init_edge, best_threshold, best_edge, ge);
+        return;
+    }
+
     double ge_edge;
     double ge_threshold;
     double le_edge;
@@ -307,6 +389,52 @@ void DecisionStump::find_best_threshold(const size_t& index,
 }
 
 
+void DecisionStump::find_best_threshold_pattern_only(const size_t& index,
+                                                     const DenseVector& dist,
+                                                     const double& init_edge,
+                                                     double& best_threshold,
+                                                     double& best_edge,
+                                                     bool& ge) const
+{
+    const SparseVector& feature = data[index];
+
+    // same thresholds as the sorted scans: 1 for the stump that always
+    // predicts 1 if the feature is present everywhere, 0 otherwise
+    ge = true;
+    best_edge = init_edge;
+    best_threshold = 1.0;
+    if(feature.nnz == feature.dim)
+    {
+        return;
+    }
+    best_threshold = 0.0;
+
+    double present_edge = 0.0;
+    for(size_t i = 0; i < feature.nnz; i++)
+    {
+        const size_t example = feature.index[i];
+        present_edge += dist.val[example]*labels[example];
+    }
+    const double absent_edge = init_edge - present_edge;
+
+    // x >= 1 predicts 1 where the feature is present, -1 elsewhere
+    if(present_edge - absent_edge > best_edge)
+    {
+        best_edge = present_edge - absent_edge;
+        best_threshold = 1.0;
+    }
+
+    // x <= 0 predicts 1 where the feature is absent
+    if(less_than and (absent_edge - present_edge > best_edge))
+    {
+        best_edge = absent_edge - present_edge;
+        best_threshold = 0.0;
+        ge = false;
+    }
+    return;
+}
+
+
 DenseIntegerVector DecisionStump::argsort(SparseVector unsorted)
 {
 
@@ -4,7 +4,6 @@
 
 #include "AbstractOracle.hpp"
 
-#include "Timer.hpp"
 
 #include "math/dense_vector.hpp"
 #include "math/sparse_vector.hpp"
@@ -28,10 +27,47 @@ protected:
   // sort of correponds to reflexive
   const bool less_than;
 
+  /// argsort of each feature, empty for the binary (pattern-only) ones
   std::vector<DenseIntegerVector> sorted_data;
+
+  /// edge of the hypothesis that always predicts 1
+  double initial_edge(const DenseVector& dist) const;
+
+  /// the stump of feature index, thresholded at threshold
+  /// (x >= threshold if ge==true, x <= threshold otherwise)
+  AbstractWeakLearner* make_weak_learner(const size_t index,
+                                         const double threshold,
+                                         const bool ge,
+                                         const DenseVector& dist) const;
+
+  /// given a sorted vector of (hyp,label,dist) triplets,
+  /// return the best threshold and edge for hyp <= thresh
+  /// (not for the pattern-only features, they have no sorted_data)
+  void find_best_threshold_less_or_equal(const size_t& index,
+                   const double& dist_diff, 
+                   const DenseVector& dist, 
+                   const double& init_edge,
+                   double& best_threshold, 
+                   double& best_edge) const;
+
+  // given a sorted vector of (hyp,label,dist) triplets,
+  // return the best threshold and edge for hyp >= thresh
+  // (not for the pattern-only features)
+  void find_best_threshold_greater_or_equal(const size_t& index,
+                   const double& dist_diff, 
+                   const DenseVector& dist, 
+                   const double& init_edge,
+                   double& best_threshold, 
+                   double& best_edge) const;
   
-  // Keep track of time spent in max_edge_wl
-  Timer timer;
+  /// find_best_threshold of a binary feature (pattern-only in data):
+  /// its only stumps are present / absent, O(nnz) without sorted_data
+  void find_best_threshold_pattern_only(const size_t& index,
+                                        const DenseVector& dist,
+                                        const double& init_edge,
+                                        double& best_threshold,
+                                        double& best_edge,
+                                        bool& ge) const;
   
 public:
   DecisionStump(const std::vector<SparseVector>& data,
@@ -43,6 +79,10 @@ public:
   /// given distribution return weak learner with maximum edge
   AbstractWeakLearner* find_maximum_edge_weak_learner(const DenseVector& dist);
 
+  /// best stump of each feature, the k best features
+  std::vector<AbstractWeakLearner*> find_top_k_weak_learners(const DenseVector& dist,
+                                                             const size_t k);
+
   /// given a hypothesis and distribution, return the best threshold
   /// the best edge, and the direction of the best threshold
   /// if ge==true, then x >= thresh else x <= thresh
@@ -53,24 +93,6 @@ public:
                 double& best_edge, 
                 bool& ge) const;
   
-  /// given a sorted vector of (hyp,label,dist) triplets,
-  /// return the best threshold and edge for hyp <= thresh
-  void find_best_threshold_less_or_equal(const size_t& index,
-                   const double& dist_diff, 
-                   const DenseVector& dist, 
-                   const double& init_edge,
-                   double& best_threshold, 
-                   double& best_edge) const;
-
-  // given a sorted vector of (hyp,label,dist) triplets,
-  // return the best threshold and edge for hyp >= thresh
-  void find_best_threshold_greater_or_equal(const size_t& index,
-                   const double& dist_diff, 
-                   const DenseVector& dist, 
-                   const double& init_edge,
-                   double& best_threshold, 
-                   double& best_edge) const;
-  
   DenseIntegerVector argsort(SparseVector unsorted);
   
 };
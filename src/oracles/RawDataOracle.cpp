@@ -1,10 +1,11 @@
 
 #include "RawDataOracle.hpp"
 
-#include "weak_learners/LinearWeakLearner.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
 
 #include "math/vector_operations.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -28,10 +29,8 @@ RawDataOracle::~RawDataOracle()
     return;
 }
 
-AbstractWeakLearner* RawDataOracle::find_maximum_edge_weak_learner(const DenseVector& dist){
-
-    DenseVector edges;
-
+void RawDataOracle::compute_edges(const DenseVector& dist, DenseVector& edges) const
+{
     assert(labels.size() == (size_t) dist.dim);
 
     DenseVector dist_labels(dist.dim);
@@ -44,6 +43,14 @@ AbstractWeakLearner* RawDataOracle::find_maximum_edge_weak_learner(const DenseVe
         dot(data, dist_labels, edges);
     else
         transpose_dot(data, dist_labels, edges);
+    return;
+}
+
+
+AbstractWeakLearner* RawDataOracle::find_maximum_edge_weak_learner(const DenseVector& dist){
+
+    DenseVector edges;
+    compute_edges(dist, edges);
 
     size_t max_index = 0;
     double max_edge = -std::numeric_limits<double>::max();
@@ -66,46 +73,58 @@ AbstractWeakLearner* RawDataOracle::find_maximum_edge_weak_learner(const DenseVe
 
     if(reflexive and (min_edge < 0) and (-min_edge > max_edge))
     {
-
         // return the negation of the min_edge feature
-        SparseVector wt(edges.dim, 1);
-
-        wt.index[0] = min_index;
-        wt.val[0] = -1.0;
-
-        SparseVector prediction;
-        if(transposed){
-            prediction = data[min_index];
-            scale(prediction, -1.0);
-        }else
-            dot(data, wt, prediction);
+        return make_weak_learner(min_index, -1.0, -min_edge, edges.dim);
+    }
 
+    // return the max_edge feature
+    return make_weak_learner(max_index, 1.0, max_edge, edges.dim);
+}
 
-        // Multiply the predictions with the labels here
-        for(size_t i = 0; i < prediction.nnz; i++)
-            prediction.val[i] *= labels[prediction.index[i]];
 
-        double edge = -min_edge;
+std::vector<AbstractWeakLearner*> RawDataOracle::find_top_k_weak_learners(const DenseVector& dist,
+                                                                          const size_t k)
+{
+    DenseVector edges;
+    compute_edges(dist, edges);
 
-        // When the weak learner goes out of scope
-        // wt and prediction vectors are deleted and the memory is freed
+    // each feature enters once, negated if that is better
+    std::vector<double> scores(edges.dim);
+    for(size_t i = 0; i < edges.dim; i++)
+    {
+        scores[i] = reflexive? std::max(edges.val[i], -edges.val[i]) : edges.val[i];
+    }
 
-        //return CWeakLearner(wt, edge, prediction);
-        AbstractWeakLearner* wl = new LinearWeakLearner(wt, edge, prediction);
-        //std::cout << "hyp: " << min_index << std::endl;
-        return wl;
+    const std::vector<size_t> selected = top_k_indices(scores, k);
+    std::vector<AbstractWeakLearner*> weak_learners;
+    for(size_t j = 0; j < selected.size(); j++)
+    {
+        const size_t index = selected[j];
+        const double sign = (scores[index] == edges.val[index])? 1.0 : -1.0;
+        weak_learners.push_back(make_weak_learner(index, sign, scores[index], edges.dim));
     }
+    return weak_learners;
+}
 
-    // return the max_edge feature
 
-    SparseVector wt(edges.dim, 1);
-    wt.index[0] = max_index;
-    wt.val[0] = 1.0;
+AbstractWeakLearner* RawDataOracle::make_weak_learner(const size_t index,
+                                                      const double sign,
+                                                      const double edge,
+                                                      const size_t num_hypotheses) const
+{
+    SparseVector wt(num_hypotheses, 1);
+    wt.index[0] = index;
+    wt.val[0] = sign;
 
     SparseVector prediction;
-    if(transposed)
-        prediction = data[max_index];
-    else
+    if(transposed){
+        prediction = data[index];
+        if(sign < 0)
+            scale(prediction, -1.0);
+        // the model refers to the features of the full data
+        wt.dim = original_num_features(num_hypotheses);
+        wt.index[0] = original_feature(index);
+    }else
         dot(data, wt, prediction);
 
 
@@ -113,10 +132,9 @@ AbstractWeakLearner* RawDataOracle::find_maximum_edge_weak_learner(const DenseVe
     for(size_t i = 0; i < prediction.nnz; i++)
         prediction.val[i] *= labels[prediction.index[i]];
 
-    double edge = max_edge;
-
-    AbstractWeakLearner* wl = new LinearWeakLearner(wt, edge, prediction);
-    //std::cout << "hyp: " << min_index << std::endl;
+    // When the weak learner goes out of scope
+    // wt and prediction vectors are deleted and the memory is freed
+    AbstractWeakLearner* wl = weak_learner_pool->new_linear(wt, edge, prediction);
     return wl;
 }
 
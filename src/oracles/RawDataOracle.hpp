@@ -14,6 +14,15 @@ class RawDataOracle: public AbstractOracle {
 private:
     bool reflexive; /// if true then training set is [data, -data]
 
+    /// edge of each feature
+    void compute_edges(const DenseVector& dist, DenseVector& edges) const;
+
+    /// weak learner of feature index (among num_hypotheses), negated if sign < 0
+    AbstractWeakLearner* make_weak_learner(const size_t index,
+                                           const double sign,
+                                           const double edge,
+                                           const size_t num_hypotheses) const;
+
 public:
     RawDataOracle(
             const std::vector<SparseVector>& data,
@@ -25,6 +34,10 @@ public:
     /// given distribution return weak learner with maximum edge
     AbstractWeakLearner* find_maximum_edge_weak_learner(const DenseVector& dist);
 
+    /// the k features with the largest edges (or negated edges, if reflexive)
+    std::vector<AbstractWeakLearner*> find_top_k_weak_learners(const DenseVector& dist,
+                                                               const size_t k);
+
 };
 
 } // end of namespace totally_corrective_boosting
@@ -2,8 +2,9 @@
 
 #include "math/vector_operations.hpp"
 
-#include "weak_learners/LinearWeakLearner.hpp"
+#include "weak_learners/WeakLearnerPool.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -29,11 +30,8 @@ Svm::~Svm()
 }
 
 
-AbstractWeakLearner* Svm::find_maximum_edge_weak_learner(const DenseVector& dist)
+void Svm::compute_edges(const DenseVector& dist, DenseVector& edges) const
 {
-
-    DenseVector edges;
-
     assert(labels.size() == (size_t) dist.dim);
 
     DenseVector dist_labels(dist.dim);
@@ -50,6 +48,15 @@ AbstractWeakLearner* Svm::find_maximum_edge_weak_learner(const DenseVector& dist
         transpose_dot(data, dist_labels, tmp_edges);
         dot(data, tmp_edges, edges);
     }
+    return;
+}
+
+
+AbstractWeakLearner* Svm::find_maximum_edge_weak_learner(const DenseVector& dist)
+{
+
+    DenseVector edges;
+    compute_edges(dist, edges);
 
     // std::cout << "edges: " << edges << std::endl;
     size_t max_index = 0;
@@ -74,44 +81,57 @@ AbstractWeakLearner* Svm::find_maximum_edge_weak_learner(const DenseVector& dist
     // std::cout << min_edge << "  " << min_index << "  " << max_edge << " " << max_index << std::endl;
     if(reflexive and (min_edge < 0) and (-min_edge > max_edge)){
         // wt = -x of the point with the max edge
-        SparseVector wt;
-        SparseVector prediction;
-        if(transposed){
-            SparseVector tmp(edges.dim, 1);
-            tmp.index[0] = min_index;
-            tmp.val[0] = -1.0;
-            dot(data, tmp, wt);
-            transpose_dot(data, wt, prediction);
-        }else{
-            wt = data[min_index];
-            scale(wt, -1.0);
-            dot(data, wt, prediction);
-        }
-        
-        // Multiply the predictions with the labels here
-        for(size_t i = 0; i < prediction.nnz; i++)
-            prediction.val[i] *= labels[prediction.index[i]];
+        return make_weak_learner(min_index, -1.0, -min_edge, edges.dim);
+    }
+
+    // return the max_edge feature
+    // wt = x of the point with the max edge
+    return make_weak_learner(max_index, 1.0, max_edge, edges.dim);
+}
 
-        double edge = -min_edge;
-        // std::cout << "reflexive : " << min_index << "  " << edge << std::endl;
 
-        AbstractWeakLearner* wl = new LinearWeakLearner(wt, edge, prediction);
-        return wl;
+std::vector<AbstractWeakLearner*> Svm::find_top_k_weak_learners(const DenseVector& dist,
+                                                                const size_t k)
+{
+    DenseVector edges;
+    compute_edges(dist, edges);
+
+    // each point enters once, negated if that is better
+    std::vector<double> scores(edges.dim);
+    for(size_t i = 0; i < edges.dim; i++)
+    {
+        scores[i] = reflexive? std::max(edges.val[i], -edges.val[i]) : edges.val[i];
     }
 
-    // return the max_edge feature
+    const std::vector<size_t> selected = top_k_indices(scores, k);
+    std::vector<AbstractWeakLearner*> weak_learners;
+    for(size_t j = 0; j < selected.size(); j++)
+    {
+        const size_t index = selected[j];
+        const double sign = (scores[index] == edges.val[index])? 1.0 : -1.0;
+        weak_learners.push_back(make_weak_learner(index, sign, scores[index], edges.dim));
+    }
+    return weak_learners;
+}
 
-    // wt = x of the point with the max edge
+
+AbstractWeakLearner* Svm::make_weak_learner(const size_t index,
+                                            const double sign,
+                                            const double edge,
+                                            const size_t num_hypotheses) const
+{
     SparseVector wt;
     SparseVector prediction;
     if(transposed){
-        SparseVector tmp(edges.dim, 1);
-        tmp.index[0] = max_index;
-        tmp.val[0] = 1.0;
+        SparseVector tmp(num_hypotheses, 1);
+        tmp.index[0] = index;
+        tmp.val[0] = sign;
         dot(data, tmp, wt);
         transpose_dot(data, wt, prediction);
     }else{
-        wt = data[max_index];
+        wt = data[index];
+        if(sign < 0)
+            scale(wt, -1.0);
         dot(data, wt, prediction);
     }
 
@@ -119,10 +139,7 @@ AbstractWeakLearner* Svm::find_maximum_edge_weak_learner(const DenseVector& dist
     for(size_t i = 0; i < prediction.nnz; i++)
         prediction.val[i] *= labels[prediction.index[i]];
 
-    double edge = max_edge;
-    // std::cout << "non reflexive : " << max_index << "  " << edge << std::endl;
-
-    AbstractWeakLearner* wl = new LinearWeakLearner(wt, edge, prediction);
+    AbstractWeakLearner* wl = weak_learner_pool->new_linear(wt, edge, prediction);
     return wl;
 }
 
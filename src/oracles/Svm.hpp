@@ -19,6 +19,15 @@ private:
     /// if true then training set is [data, -data]
     bool reflexive;
 
+    /// edge of each point, X^{\top} X (d*y)
+    void compute_edges(const DenseVector& dist, DenseVector& edges) const;
+
+    /// weak learner of point index (among num_hypotheses), negated if sign < 0
+    AbstractWeakLearner* make_weak_learner(const size_t index,
+                                           const double sign,
+                                           const double edge,
+                                           const size_t num_hypotheses) const;
+
 public:
     Svm(const std::vector<SparseVector>& data,
         const std::vector<int>& labels,
@@ -29,6 +38,10 @@ public:
     /// given distribution return weak learner with maximum edge
     AbstractWeakLearner* find_maximum_edge_weak_learner(const DenseVector& dist);
 
+    /// the k points with the largest edges (or negated edges, if reflexive)
+    std::vector<AbstractWeakLearner*> find_top_k_weak_learners(const DenseVector& dist,
+                                                               const size_t k);
+
 };
 
 } // end of namespace totally_corrective_boosting
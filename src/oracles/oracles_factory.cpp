@@ -4,6 +4,8 @@
 #include "Svm.hpp"
 #include "DecisionStump.hpp"
 
+#include "FeatureCompaction.hpp"
+
 #include <string>
 #include <stdexcept>
 
@@ -25,12 +27,36 @@ AbstractOracle *new_oracle_instance(const ConfigFile &config,
 
     log_stream << "Using oracle_type == " << oracle_type << std::endl;
 
+    // the oracle only scans the features that can give a weak learner
+    // of their own
+    bool compact = false;
+    config.readInto(compact, "compact_features", false);
+
+    std::vector<SparseVector> compacted;
+    std::vector<size_t> original_features;
+    if(compact)
+    {
+        if(not transposed)
+        {
+            throw std::invalid_argument("compact_features needs the transposed data");
+        }
+        if(oracle_type == "svm")
+        {
+            throw std::invalid_argument("compact_features does not apply to the svm oracle, "
+                                        "its weak learners combine all the features");
+        }
+        // a constant feature gives the same stumps as any other one
+        compact_features(data, oracle_type == "decisionstump", compacted, original_features);
+        log_stream << "Compacted the features: " << compacted.size()
+                   << " distinct features out of " << data.size() << std::endl;
+    }
+    const std::vector<SparseVector> &oracle_data = compact? compacted : data;
 
     AbstractOracle* oracle = NULL;
 
     if(oracle_type == "rawdata")
     {
-        oracle = new RawDataOracle(data, labels, transposed, reflexive);
+        oracle = new RawDataOracle(oracle_data, labels, transposed, reflexive);
     }
     else if(oracle_type == "svm")
     {
@@ -38,7 +64,7 @@ AbstractOracle *new_oracle_instance(const ConfigFile &config,
     }
     else if(oracle_type == "decisionstump")
     {
-        oracle = new DecisionStump(data, labels, reflexive);
+        oracle = new DecisionStump(oracle_data, labels, reflexive);
     }
     else
     {
@@ -46,6 +72,11 @@ AbstractOracle *new_oracle_instance(const ConfigFile &config,
         throw std::runtime_error("Received an unknown value for oracle_type");
     }
 
+    if(compact)
+    {
+        oracle->set_original_features(original_features, data.size());
+    }
+
     return oracle;
 }
 
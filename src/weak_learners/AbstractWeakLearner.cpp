@@ -1,5 +1,7 @@
 #include "AbstractWeakLearner.hpp"
 
+#include "MemoryAccounting.hpp"
+
 namespace totally_corrective_boosting {
 
 AbstractWeakLearner::AbstractWeakLearner()
@@ -12,14 +14,14 @@ AbstractWeakLearner::AbstractWeakLearner()
 AbstractWeakLearner::AbstractWeakLearner(const double &edge_, const SparseVector &prediction_)
     : edge(edge_), prediction(prediction_)
 {
-    // nothing to do here
+    MemoryAccounting::allocate(MemoryAccounting::weak_learner_predictions, MemoryAccounting::bytes(prediction));
     return;
 }
 
 
 AbstractWeakLearner::~AbstractWeakLearner()
 {
-    // nothing to do here
+    MemoryAccounting::release(MemoryAccounting::weak_learner_predictions, MemoryAccounting::bytes(prediction));
     return;
 }
 
@@ -40,6 +40,8 @@ public:
     virtual void dump(std::ostream& os) const = 0;
     virtual void load(std::istream& in) = 0;
     virtual bool equal(const AbstractWeakLearner *wl) const = 0;
+    /// equal weak learners have equal hashes (see Ensemble::add)
+    virtual size_t hash() const = 0;
     virtual std::string get_type() const = 0;
 
     double get_edge() const { return edge; }
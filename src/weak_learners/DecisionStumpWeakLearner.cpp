@@ -4,6 +4,8 @@
 #include "parse.hpp"
 #include "math/vector_operations.hpp"
 
+#include <boost/functional/hash.hpp>
+
 #include <cassert>
 #include <iostream>
 
@@ -166,6 +168,17 @@ bool DecisionStumpWeakLearner::equal(const AbstractWeakLearner *other_p) const
 }
 
 
+size_t DecisionStumpWeakLearner::hash() const
+{
+    // wt only depends on index
+    size_t seed = 0;
+    boost::hash_combine(seed, index);
+    boost::hash_combine(seed, (threshold == 0.0)? 0.0 : threshold);
+    boost::hash_combine(seed, direction);
+    return seed;
+}
+
+
 std::ostream& operator << (std::ostream& os, const DecisionStumpWeakLearner& wl){
     wl.dump(os);
     return os;
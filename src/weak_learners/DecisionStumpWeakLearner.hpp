@@ -50,6 +50,7 @@ public:
     void dump(std::ostream& os) const;
     void load(std::istream& in);
     bool equal(const AbstractWeakLearner *wl) const;
+    size_t hash() const;
 
     // accessor methods
     bool get_direction() const {return direction; }
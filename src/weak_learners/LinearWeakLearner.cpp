@@ -103,4 +103,10 @@ bool LinearWeakLearner::equal(const AbstractWeakLearner *other_p) const
 }
 
 
+size_t LinearWeakLearner::hash() const
+{
+    return hash_value(wt);
+}
+
+
 } // end of namespace totally_corrective_boosting
@@ -39,9 +39,10 @@ public:
     void dump(std::ostream& os) const;
     void load(std::istream& in);
     bool equal(const AbstractWeakLearner *other_p) const;
+    size_t hash() const;
     std::string get_type() const;
 
-    SparseVector get_wt() const { return wt; }
+    const SparseVector& get_wt() const { return wt; }
 
     // ugly hack. Need to figure out how to avoid.
     bool get_direction() const {return false; }
@@ -0,0 +1,128 @@
+#include "WeakLearnerPool.hpp"
+
+#include <new>
+#include <stdexcept>
+
+namespace totally_corrective_boosting {
+
+namespace
+{
+
+/// Storage from the slab, released if the constructor throws
+template <typename T>
+class PoolChunk
+{
+    boost::object_pool<T>& pool;
+    T *chunk;
+
+public:
+    PoolChunk(boost::object_pool<T>& pool)
+        : pool(pool), chunk(pool.malloc())
+    {
+        if(chunk == NULL)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    ~PoolChunk()
+    {
+        if(chunk != NULL)
+        {
+            pool.free(chunk);
+        }
+    }
+
+    void* get() const
+    {
+        return chunk;
+    }
+
+    /// The object is constructed, the pool owns it
+    T* release(T *constructed)
+    {
+        chunk = NULL;
+        return constructed;
+    }
+};
+
+} // end of anonymous namespace
+
+
+WeakLearnerPool::WeakLearnerPool()
+{
+    // nothing to do here
+    return;
+}
+
+
+WeakLearnerPool::~WeakLearnerPool()
+{
+    // the object pools destroy the weak learners left
+    return;
+}
+
+
+DecisionStumpWeakLearner* WeakLearnerPool::new_stump()
+{
+    PoolChunk<DecisionStumpWeakLearner> chunk(stumps);
+    return chunk.release(new (chunk.get()) DecisionStumpWeakLearner());
+}
+
+
+LinearWeakLearner* WeakLearnerPool::new_linear()
+{
+    PoolChunk<LinearWeakLearner> chunk(linear_learners);
+    return chunk.release(new (chunk.get()) LinearWeakLearner());
+}
+
+
+DecisionStumpWeakLearner* WeakLearnerPool::new_stump(const SparseVector& wt,
+                                                     const double edge,
+                                                     const SparseVector& prediction,
+                                                     const double threshold,
+                                                     const bool direction,
+                                                     const size_t index)
+{
+    PoolChunk<DecisionStumpWeakLearner> chunk(stumps);
+    return chunk.release(new (chunk.get()) DecisionStumpWeakLearner(wt, edge, prediction,
+                                                                    threshold, direction, index));
+}
+
+
+LinearWeakLearner* WeakLearnerPool::new_linear(const SparseVector& wt,
+                                               const double edge,
+                                               const SparseVector& prediction)
+{
+    PoolChunk<LinearWeakLearner> chunk(linear_learners);
+    return chunk.release(new (chunk.get()) LinearWeakLearner(wt, edge, prediction));
+}
+
+
+void WeakLearnerPool::destroy(const AbstractWeakLearner* wl)
+{
+    AbstractWeakLearner *mutable_wl = const_cast<AbstractWeakLearner *>(wl);
+
+    // stumps are linear weak learners too, look at the most derived type first
+    DecisionStumpWeakLearner *stump = dynamic_cast<DecisionStumpWeakLearner *>(mutable_wl);
+    if(stump != NULL)
+    {
+        if(not stumps.is_from(stump))
+        {
+            throw std::invalid_argument("The decision stump does not belong to this weak learner pool");
+        }
+        stumps.destroy(stump);
+        return;
+    }
+
+    LinearWeakLearner *linear = dynamic_cast<LinearWeakLearner *>(mutable_wl);
+    if(linear == NULL or not linear_learners.is_from(linear))
+    {
+        throw std::invalid_argument("The weak learner does not belong to this weak learner pool");
+    }
+    linear_learners.destroy(linear);
+    return;
+}
+
+
+} // end of namespace totally_corrective_boosting
@@ -0,0 +1,65 @@
+#ifndef _WEAKLEARNERPOOL_HPP_
+#define _WEAKLEARNERPOOL_HPP_
+
+#include "DecisionStumpWeakLearner.hpp"
+#include "LinearWeakLearner.hpp"
+
+#include <boost/pool/object_pool.hpp>
+
+namespace totally_corrective_boosting {
+
+
+/// Owns weak learners, in one slab per type.
+///
+/// The ensembles share their pool (WeightedWeakLearner only points to
+/// the weak learners), and the oracles allocate the weak learners they
+/// return from the pool they were given. A weak learner that did not make
+/// it into the model goes back with destroy(), all the others are
+/// destroyed with the pool.
+class WeakLearnerPool
+{
+
+protected:
+
+    boost::object_pool<DecisionStumpWeakLearner> stumps;
+
+    boost::object_pool<LinearWeakLearner> linear_learners;
+
+private:
+
+    // not copyable
+    WeakLearnerPool(const WeakLearnerPool &);
+    WeakLearnerPool &operator=(const WeakLearnerPool &);
+
+public:
+
+    WeakLearnerPool();
+
+    ~WeakLearnerPool();
+
+    /// Empty weak learners, to be loaded from a model file
+    /// @{
+    DecisionStumpWeakLearner* new_stump();
+    LinearWeakLearner* new_linear();
+    /// @}
+
+    DecisionStumpWeakLearner* new_stump(const SparseVector& wt,
+                                        const double edge,
+                                        const SparseVector& prediction,
+                                        const double threshold,
+                                        const bool direction,
+                                        const size_t index);
+
+    LinearWeakLearner* new_linear(const SparseVector& wt,
+                                  const double edge,
+                                  const SparseVector& prediction);
+
+    /// wl must come from this pool
+    void destroy(const AbstractWeakLearner* wl);
+
+};
+
+
+} // end of namespace totally_corrective_boosting
+
+#endif // _WEAKLEARNERPOOL_HPP_
@@ -43,6 +43,11 @@ public:
         weight += alpha;
     }
 
+    const AbstractWeakLearner* get_weak_learner() const
+    {
+        return weak_learner;
+    }
+
     std::string get_type() const
     {
         return weak_learner->get_type();